@@ -43,6 +43,24 @@ declare class GameObject {
     rotation: number;
 }
 
+/**
+ * Counts of what the level consists of. Maps are keyed by object ID, editor 
+ * layer, color channel or group ID
+ */
+declare interface LevelStats {
+    objectCount: number;
+    /**
+     * Amount of objects that are hidden in Low Detail Mode
+     */
+    ldmCount: number;
+    triggerCount: number;
+    objectsByID: Record<number, number>;
+    objectsByLayer: Record<number, number>;
+    objectsByColor: Record<number, number>;
+    objectsByGroup: Record<number, number>;
+    triggersByID: Record<number, number>;
+}
+
 /**
  * Interface for interacting with the level editor
  */
@@ -68,6 +86,13 @@ declare class Editor {
      * Get the current center of the screen
      */
     getViewCenter(): Point;
+    /**
+     * Get statistics about the level, like how many objects of each type 
+     * there are. This is cheap to call even on huge levels, as the counts are 
+     * kept up to date as the level is edited. Returns null if the level is 
+     * still loading
+     */
+    getLevelStats(): LevelStats | null;
 
     addEventListener<K extends keyof EditorEventListeners>(event: K, onEvent: EditorEventListeners[K]): void;
 }
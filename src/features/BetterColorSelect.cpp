@@ -72,12 +72,12 @@ struct NextFreeColorIDSource final {
     static constexpr int MIN_VALUE = 1;
     static constexpr int MAX_VALUE = 999;
 
-    static void getUsedIDs(GameObject* obj, std::unordered_set<int>& used) {
+    static void getUsedIDs(GameObject* obj, std::vector<int>& used) {
         if (obj->m_detailColor) {
-            used.insert(obj->m_detailColor->m_colorID);
+            used.push_back(obj->m_detailColor->m_colorID);
         }
         if (obj->m_baseColor) {
-            used.insert(obj->m_baseColor->m_colorID);
+            used.push_back(obj->m_baseColor->m_colorID);
         }
     }
 };
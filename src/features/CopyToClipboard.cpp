@@ -1,7 +1,10 @@
+#include "CopyToClipboard.hpp"
 #include <Geode/modify/EditorUI.hpp>
 #include <Geode/utils/general.hpp>
 #include <Geode/ui/Notification.hpp>
 #include <Geode/binding/GameManager.hpp>
+#include <utils/GroupIndex.hpp>
+#include <utils/GroupRemap.hpp>
 
 using namespace geode::prelude;
 
@@ -43,3 +46,34 @@ class $modify(EditorUI) {
         }
     }
 };
+
+static std::string getObjectsToPaste() {
+    if (
+        Mod::get()->template getSettingValue<bool>("copy-paste-from-clipboard") &&
+        isProbablyObjectString(clipboard::read())
+    ) {
+        return clipboard::read();
+    }
+    return GameManager::get()->m_editorClipboard;
+}
+
+void pasteWithFreshGroups(EditorUI* ui) {
+    auto index = be::GroupIndex::get();
+    const auto objects = getObjectsToPaste();
+    if (!index || objects.empty()) {
+        return;
+    }
+    // Give the objects their new groups before they are created instead of 
+    // moving them over afterwards
+    auto remap = be::GroupRemap::gather(objects);
+    if (auto res = remap.allocate(index->getUsedGroups()); !res) {
+        Notification::create(res.unwrapErr(), NotificationIcon::Error)->show();
+        return;
+    }
+    ui->pasteObjects(remap.apply(objects), false, false);
+    ui->updateButtons();
+    Notification::create(
+        fmt::format("Pasted Objects with {} Fresh Groups", remap.getGroupCount()),
+        NotificationIcon::Info
+    )->show();
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Geode/binding/EditorUI.hpp>
+
+using namespace geode::prelude;
+
+/**
+ * Paste the copied objects with all of their groups remapped to unused ones
+ */
+void pasteWithFreshGroups(EditorUI* ui);
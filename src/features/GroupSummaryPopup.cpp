@@ -8,6 +8,7 @@
 #include <Geode/binding/ButtonSprite.hpp>
 #include <Geode/ui/BasedButtonSprite.hpp>
 #include <utils/Editor.hpp>
+#include <utils/GroupIndex.hpp>
 #include <Geode/utils/ranges.hpp>
 
 static std::tuple<size_t, GroupSummaryFilter, std::string> LAST_PAGE = std::make_tuple(0, GroupSummaryFilter::All, "");
@@ -16,6 +17,51 @@ constexpr size_t ITEMS_PER_ROW = 5;
 constexpr size_t ITEMS_PER_COLUMN = 4;
 constexpr size_t ITEMS_PER_LIST = 8;
 
+// Get the ranges of group IDs that match a search query. The query is either 
+// a prefix of the group ID or an inclusive range like `100-200` (either end 
+// may be left out). All group IDs that start with the same digits form one 
+// contiguous range per digit count (1, 10-19, 100-199, ...), so the matching 
+// IDs can be enumerated directly in ascending order without checking every 
+// single group against the query
+static std::vector<std::pair<int, int>> getSearchRanges(std::string const& query) {
+    constexpr int MAX_GROUP = be::GroupIndex::MAX_GROUP_ID;
+    if (query.empty()) {
+        return { { 1, MAX_GROUP } };
+    }
+    if (auto dash = query.find('-'); dash != std::string::npos) {
+        int min = 1;
+        int max = MAX_GROUP;
+        if (dash > 0) {
+            auto from = numFromString<int>(query.substr(0, dash));
+            if (!from) {
+                return {};
+            }
+            min = std::max(from.unwrap(), 1);
+        }
+        if (dash + 1 < query.size()) {
+            auto to = numFromString<int>(query.substr(dash + 1));
+            if (!to) {
+                return {};
+            }
+            max = std::min(to.unwrap(), MAX_GROUP);
+        }
+        if (min > max) {
+            return {};
+        }
+        return { { min, max } };
+    }
+    // No group ID starts with a zero
+    auto prefix = numFromString<int>(query);
+    if (query.front() == '0' || !prefix || prefix.unwrap() > MAX_GROUP) {
+        return {};
+    }
+    std::vector<std::pair<int, int>> ranges;
+    for (int start = prefix.unwrap(), width = 1; start <= MAX_GROUP; start *= 10, width *= 10) {
+        ranges.emplace_back(start, std::min(start + width - 1, MAX_GROUP));
+    }
+    return ranges;
+}
+
 static CCSprite* createSpriteForTrigger(EffectGameObject* trigger, int group) {
     auto sprName = ObjectToolbox::sharedState()->intKeyToFrame(trigger->m_objectID);
     auto spr = CCSprite::createWithSpriteFrameName(sprName);
@@ -120,24 +166,14 @@ bool GroupSummaryPopup::setup(EditorUI* ui) {
 
     this->setTitle("View Groups");
 
-    // Load up groups to memory (holy shit an use case for multimap?????)
-    std::unordered_multimap<int, EffectGameObject*> triggersTargetingGroups {};
-    for (auto trigger : CCArrayExt<EffectGameObject*>(m_ui->m_editorLayer->m_drawGridLayer->m_effectGameObjects)) {
-        for (auto group : be::getTriggerTargetedGroups(trigger)) {
-            triggersTargetingGroups.emplace(group, trigger);
-        }
-    }
-    for (int group = 1; group < 10000; group += 1) {
-        auto objs = ObjectsInGroupID {
-            .groupID = group,
-            .targets = be::getObjectsFromGroupDict(m_ui->m_editorLayer->m_groupDict, group),
-            .triggers = CCArray::create(),
-        };
-        auto [first, last] = triggersTargetingGroups.equal_range(group);
-        for (auto it = first; it != last; it++) {
-            objs.triggers->addObject(it->second);
+    // Figure out which groups are used so filtering doesn't need to look at 
+    // any objects; the objects themselves are only fetched for the groups on 
+    // the current page
+    if (auto index = be::GroupIndex::get()) {
+        for (int group = 1; group < 10000; group += 1) {
+            m_groupsWithTargets[group] = index->getObjectCountInGroup(group) > 0;
+            m_groupsWithTriggers[group] = !index->getTriggersTargeting(group).empty();
         }
-        m_objectsInGroupsCache.emplace(group, objs);
     }
 
     m_groupsListContainer = CCNode::create();
@@ -230,7 +266,7 @@ bool GroupSummaryPopup::setup(EditorUI* ui) {
     m_buttonMenu->addChildAtPosition(m_viewMenu, Anchor::TopLeft, ccp(50, -10), ccp(0, 1));
 
     m_search = TextInput::create(m_groupsListContainer->getContentWidth() / .75f, "Search Groups");
-    m_search->setCommonFilter(CommonFilter::Uint);
+    m_search->setFilter("0123456789-");
     m_search->setTextAlign(TextInputAlign::Left);
     m_search->setScale(.75f);
     m_search->setString(lastSearchQuery);
@@ -252,8 +288,23 @@ bool GroupSummaryPopup::setup(EditorUI* ui) {
     return true;
 }
 
+ObjectsInGroupID GroupSummaryPopup::getObjectsInGroup(int group) const {
+    auto objs = ObjectsInGroupID {
+        .groupID = group,
+        .targets = be::getObjectsFromGroupDict(m_ui->m_editorLayer->m_groupDict, group),
+        .triggers = CCArray::create(),
+    };
+    if (auto index = be::GroupIndex::get()) {
+        for (auto trigger : index->getTriggersTargeting(group)) {
+            objs.triggers->addObject(trigger);
+        }
+    }
+    return objs;
+}
+
 void GroupSummaryPopup::loadPage(size_t page) {
-    const size_t lastPossiblePage = m_pages.pages.empty() ? 0 : m_pages.pages.size() - 1;
+    const size_t pageCount = m_pages.getPageCount();
+    const size_t lastPossiblePage = pageCount == 0 ? 0 : pageCount - 1;
 
     // Update page & clear existing page
     // The possible page number is clamped to number of pages
@@ -303,14 +354,15 @@ void GroupSummaryPopup::loadPage(size_t page) {
         } break;
     }
 
-    if (m_pages.pages.empty()) {
+    if (pageCount == 0) {
         auto emptyLabel = CCLabelBMFont::create("No Groups Found :(", "bigFont.fnt");
         emptyLabel->setOpacity(155);
         emptyLabel->setColor(ccc3(155, 155, 155));
         emptyLabel->setLayoutOptions(AxisLayoutOptions::create()->setScaleLimits(.1f, .5f));
         m_groupsListContainer->addChild(emptyLabel);
     }
-    else for (auto group : m_pages.pages.at(m_page)) {
+    else for (auto groupID : m_pages.getPage(m_page)) {
+        const auto group = this->getObjectsInGroup(groupID);
         constexpr float LIST_VIEW_NUM_SPACE  = 25;
         constexpr float LIST_VIEW_OBJS_SPACE = 55;
 
@@ -422,8 +474,8 @@ void GroupSummaryPopup::loadPage(size_t page) {
     }
     m_groupsListContainer->updateLayout();
 
-    m_pageLabel->setString(fmt::format("Page {}/{}", m_page + 1, m_pages.pages.size() + 1).c_str());
-    m_matchesLabel->setString(fmt::format("(showing {} groups)", m_pages.totalMatches).c_str());
+    m_pageLabel->setString(fmt::format("Page {}/{}", m_page + 1, pageCount + 1).c_str());
+    m_matchesLabel->setString(fmt::format("(showing {} groups)", m_pages.groups.size()).c_str());
 
     be::enableButton(m_prevPageBtn, m_page > 0);
     be::enableButton(m_nextPageBtn, m_page < lastPossiblePage);
@@ -438,32 +490,27 @@ void GroupSummaryPopup::updatePages(size_t page) {
     Mod::get()->setSavedValue("group-summary-view-mode", static_cast<int>(m_view));
 
     // Clear existing pages
-    m_pages.reset();
-
-    // Load up pages
     const size_t groupsPerPage = m_view == GroupSummaryView::Grid ? 
         ITEMS_PER_ROW * ITEMS_PER_COLUMN : 
         ITEMS_PER_LIST;
-    for (auto& [group, objs] : m_objectsInGroupsCache) {
-        bool matches = false;
-        bool hasTargets = objs.targets && objs.targets->count() > 0;
-        bool hasTriggers = objs.triggers->count() > 0;
-        switch (m_filter) {
-            case GroupSummaryFilter::All:        matches = true; break;
-            case GroupSummaryFilter::Used:       matches = hasTargets && hasTriggers; break;
-            case GroupSummaryFilter::Unused:     matches = !hasTargets && !hasTriggers; break;
-            case GroupSummaryFilter::NoTargets:  matches = !hasTargets && hasTriggers; break;
-            case GroupSummaryFilter::NoTriggers: matches = hasTargets && !hasTriggers; break;
-        }
-        if (m_search->getString().size() && !numToString(group).starts_with(m_search->getString())) {
-            matches = false;
-        }
-        if (matches) {
-            if (m_pages.pages.empty() || m_pages.pages.back().size() >= groupsPerPage) {
-                m_pages.pages.emplace_back();
+    m_pages.reset(groupsPerPage);
+
+    // Load up pages
+    for (auto [start, end] : getSearchRanges(m_search->getString())) {
+        for (int group = start; group <= end; group += 1) {
+            bool matches = false;
+            bool hasTargets = m_groupsWithTargets[group];
+            bool hasTriggers = m_groupsWithTriggers[group];
+            switch (m_filter) {
+                case GroupSummaryFilter::All:        matches = true; break;
+                case GroupSummaryFilter::Used:       matches = hasTargets && hasTriggers; break;
+                case GroupSummaryFilter::Unused:     matches = !hasTargets && !hasTriggers; break;
+                case GroupSummaryFilter::NoTargets:  matches = !hasTargets && hasTriggers; break;
+                case GroupSummaryFilter::NoTriggers: matches = hasTargets && !hasTriggers; break;
+            }
+            if (matches) {
+                m_pages.groups.push_back(group);
             }
-            m_pages.pages.back().push_back(objs);
-            m_pages.totalMatches += 1;
         }
     }
 
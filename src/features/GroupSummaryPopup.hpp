@@ -3,6 +3,8 @@
 #include <features/supporters/Pro.hpp>
 #include <Geode/ui/Popup.hpp>
 #include <Geode/ui/TextInput.hpp>
+#include <bitset>
+#include <span>
 
 using namespace geode::prelude;
 
@@ -24,12 +26,22 @@ struct ObjectsInGroupID final {
     Ref<CCArray> triggers;
 };
 struct Pages final {
-    std::vector<std::vector<ObjectsInGroupID>> pages;
-    size_t totalMatches;
-
-    inline void reset() {
-        this->pages.clear();
-        this->totalMatches = 0;
+    // Only the IDs of the matching groups are stored; the actual objects are 
+    // only fetched for the page that is being shown
+    std::vector<int> groups;
+    size_t groupsPerPage = 1;
+
+    inline void reset(size_t groupsPerPage) {
+        this->groups.clear();
+        this->groupsPerPage = groupsPerPage;
+    }
+    inline size_t getPageCount() const {
+        return (this->groups.size() + this->groupsPerPage - 1) / this->groupsPerPage;
+    }
+    inline std::span<const int> getPage(size_t page) const {
+        const auto start = std::min(page * this->groupsPerPage, this->groups.size());
+        const auto end = std::min(start + this->groupsPerPage, this->groups.size());
+        return std::span(this->groups).subspan(start, end - start);
     }
 };
 
@@ -54,7 +66,8 @@ protected:
     CCNode* m_groupsListContainer;
     CCMenu* m_viewMenu;
     CCMenu* m_filtersMenu;
-    std::map<int, ObjectsInGroupID> m_objectsInGroupsCache;
+    std::bitset<10000> m_groupsWithTargets;
+    std::bitset<10000> m_groupsWithTriggers;
     Pages m_pages;
     size_t m_page;
     GroupSummaryView m_view;
@@ -69,6 +82,7 @@ protected:
 
     bool setup(EditorUI* ui) override;
 
+    ObjectsInGroupID getObjectsInGroup(int group) const;
     void loadPage(size_t page);
     void updatePages(size_t page = 0);
     void onPage(CCObject* sender);
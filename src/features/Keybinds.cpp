@@ -11,6 +11,7 @@
 #include <utils/Editor.hpp>
 #include <utils/HolyUB.hpp>
 #include "GridScaling.hpp"
+#include "CopyToClipboard.hpp"
 #include <features/GroupSummaryPopup.hpp>
 
 using namespace geode::prelude;
@@ -75,6 +76,9 @@ struct $modify(EditorUI) {
         this->defineKeybind("paste-color"_spr, [this]() {
             this->onPasteColor(nullptr);
         });
+        this->defineKeybind("paste-with-fresh-groups"_spr, [this]() {
+            pasteWithFreshGroups(this);
+        });
 
         this->defineKeybind("enlarge-grid-size"_spr, [this]() {
             incrementGridSize(this);
@@ -342,6 +346,15 @@ $execute {
         Category::EDITOR_MODIFY,
         false
     ));
+    BindManager::get()->registerBindable(BindableAction(
+        "paste-with-fresh-groups"_spr,
+        "Paste with Fresh Groups",
+        "Paste the copied objects with all of their groups remapped to unused "
+        "ones, like pasting and then using <cy>Build Helper</c> on them",
+        {},
+        Category::EDITOR_MODIFY,
+        false
+    ));
 
     BindManager::get()->registerBindable(BindableAction(
         "enlarge-grid-size"_spr,
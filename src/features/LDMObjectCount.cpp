@@ -1,27 +1,54 @@
 #include <Geode/modify/EditorPauseLayer.hpp>
 #include <Geode/binding/LevelEditorLayer.hpp>
-#include <Geode/binding/GameObject.hpp>
+#include <Geode/binding/ButtonSprite.hpp>
+#include <Geode/binding/CCMenuItemSpriteExtra.hpp>
+#include <utils/LevelStats.hpp>
+#include "LevelStatsPopup.hpp"
 
 using namespace geode::prelude;
 
-class $modify(EditorPauseLayer) {
+class $modify(LevelStatsPauseLayer, EditorPauseLayer) {
     $override
     bool init(LevelEditorLayer* lel) {
         if (!EditorPauseLayer::init(lel))
             return false;
 
+        auto stats = be::LevelStats::get();
+        if (!stats) {
+            return true;
+        }
+
+        // The counts are kept up to date as the level is edited, so this 
+        // doesn't need to go through every object in the level
         if (auto label = static_cast<CCLabelBMFont*>(this->querySelector("object-count-label"))) {
-            size_t ldmCount = 0;
-            for (auto obj : CCArrayExt<GameObject*>(lel->m_objects)) {
-                ldmCount += obj->m_isHighDetail;
-            }
+            const auto ldmCount = stats->getHighDetailCount();
+            // Same total as the game's own label
+            const auto objectCount = lel->m_objects->count();
             label->setString(fmt::format(
                 "{} | LDM: {} ({}%)",
                 label->getString(), ldmCount,
-                lel->m_objects->count() ? static_cast<int>(100.f * ldmCount / lel->m_objects->count()) : 0
+                objectCount ? static_cast<int>(100.f * ldmCount / objectCount) : 0
             ).c_str());
         }
+
+        if (auto menu = this->getChildByID("small-actions-menu")) {
+            auto statsSpr = ButtonSprite::create(
+                "Level\nStats", 30, 0, .4f, true,
+                "bigFont.fnt", "GJ_button_04.png", 30.f
+            );
+            statsSpr->setScale(.8f);
+            auto statsBtn = CCMenuItemSpriteExtra::create(
+                statsSpr, this, menu_selector(LevelStatsPauseLayer::onLevelStats)
+            );
+            statsBtn->setID("level-stats-button"_spr);
+            menu->insertBefore(statsBtn, nullptr);
+            menu->updateLayout();
+        }
         
         return true;
     }
+
+    void onLevelStats(CCObject*) {
+        LevelStatsPopup::create()->show();
+    }
 };
@@ -0,0 +1,80 @@
+#include "LevelStatsPopup.hpp"
+#include <utils/LevelStats.hpp>
+
+static constexpr size_t TOP_ENTRY_COUNT = 5;
+
+static std::string formatTop(be::LevelStats::Counts const& counts, std::string_view name) {
+    std::vector<std::pair<int, size_t>> sorted(counts.begin(), counts.end());
+    const auto count = std::min(sorted.size(), TOP_ENTRY_COUNT);
+    std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(), [](auto const& a, auto const& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    std::string result;
+    for (size_t i = 0; i < count; i += 1) {
+        result += fmt::format("{}{} {}: {}", i ? "\n" : "", name, sorted[i].first, sorted[i].second);
+    }
+    return result.size() ? result : "None";
+}
+
+bool LevelStatsPopup::setup() {
+    m_noElasticity = true;
+    this->setTitle("Level Stats");
+
+    auto stats = be::LevelStats::get();
+    if (!stats) {
+        return true;
+    }
+
+    const auto objectCount = stats->getObjectCount();
+    auto summary = CCLabelBMFont::create(fmt::format(
+        "Objects: {}\n"
+        "LDM Objects: {} ({}%)\n"
+        "Triggers: {}\n"
+        "Groups Used: {}\n"
+        "Editor Layers Used: {}\n"
+        "Color Channels Used: {}",
+        objectCount,
+        stats->getHighDetailCount(),
+        objectCount ? static_cast<int>(100.f * stats->getHighDetailCount() / objectCount) : 0,
+        stats->getTriggerCount(),
+        stats->getObjectsByGroup().size(),
+        stats->getObjectsByLayer().size(),
+        stats->getObjectsByColor().size()
+    ).c_str(), "bigFont.fnt");
+    summary->setScale(.35f);
+    summary->setAlignment(kCCTextAlignmentLeft);
+    summary->setAnchorPoint(ccp(0, 1));
+    m_mainLayer->addChildAtPosition(summary, Anchor::TopLeft, ccp(20, -35));
+
+    auto topObjectsTitle = CCLabelBMFont::create("Most Used Objects", "goldFont.fnt");
+    topObjectsTitle->setScale(.5f);
+    m_mainLayer->addChildAtPosition(topObjectsTitle, Anchor::Left, ccp(80, -20));
+
+    auto topObjects = CCLabelBMFont::create(formatTop(stats->getObjectsByID(), "ID").c_str(), "bigFont.fnt");
+    topObjects->setScale(.3f);
+    topObjects->setAlignment(kCCTextAlignmentLeft);
+    topObjects->setAnchorPoint(ccp(.5f, 1));
+    m_mainLayer->addChildAtPosition(topObjects, Anchor::Left, ccp(80, -30));
+
+    auto topTriggersTitle = CCLabelBMFont::create("Most Used Triggers", "goldFont.fnt");
+    topTriggersTitle->setScale(.5f);
+    m_mainLayer->addChildAtPosition(topTriggersTitle, Anchor::Right, ccp(-80, -20));
+
+    auto topTriggers = CCLabelBMFont::create(formatTop(stats->getTriggersByID(), "ID").c_str(), "bigFont.fnt");
+    topTriggers->setScale(.3f);
+    topTriggers->setAlignment(kCCTextAlignmentLeft);
+    topTriggers->setAnchorPoint(ccp(.5f, 1));
+    m_mainLayer->addChildAtPosition(topTriggers, Anchor::Right, ccp(-80, -30));
+
+    return true;
+}
+
+LevelStatsPopup* LevelStatsPopup::create() {
+    auto ret = new LevelStatsPopup();
+    if (ret && ret->initAnchored(320, 240)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
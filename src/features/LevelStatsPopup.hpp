@@ -0,0 +1,13 @@
+#pragma once
+
+#include <Geode/ui/Popup.hpp>
+
+using namespace geode::prelude;
+
+class LevelStatsPopup : public Popup<> {
+protected:
+    bool setup() override;
+
+public:
+    static LevelStatsPopup* create();
+};
@@ -2,6 +2,7 @@
 #include <Geode/modify/SetGroupIDLayer.hpp>
 #include <utils/NextFreeOffsetInput.hpp>
 #include <utils/Warn.hpp>
+#include <utils/GroupIndex.hpp>
 #include <Geode/binding/GameObject.hpp>
 #include <Geode/binding/EffectGameObject.hpp>
 
@@ -13,21 +14,30 @@ struct GroupIDSource final {
     static constexpr short MIN_VALUE = 1;
     static constexpr short MAX_VALUE = 9999;
 
-    static void getUsedIDs(GameObject* obj, std::unordered_set<short>& used) {
+    static void getUsedIDs(GameObject* obj, std::vector<short>& used) {
         for (short i = 0; i < obj->m_groupCount; i += 1) {
-            used.insert(obj->m_groups->at(i));
+            used.push_back(obj->m_groups->at(i));
         }
         for (short i = 0; i < obj->m_colorGroupCount; i += 1) {
-            used.insert(obj->m_colorGroups->at(i));
+            used.push_back(obj->m_colorGroups->at(i));
         }
         for (short i = 0; i < obj->m_opacityGroupCount; i += 1) {
-            used.insert(obj->m_opacityGroups->at(i));
+            used.push_back(obj->m_opacityGroups->at(i));
         }
         if (auto eobj = typeinfo_cast<EffectGameObject*>(obj)) {
-            used.insert(eobj->m_centerGroupID);
-            used.insert(eobj->m_targetGroupID);
+            used.push_back(eobj->m_centerGroupID);
+            used.push_back(eobj->m_targetGroupID);
         }
     }
+
+    // The index doesn't count the color and opacity group lists, since those 
+    // are only filled in while playtesting and are empty in the editor
+    static be::UsedIDBitset const* getUsedIDIndex() {
+        if (auto index = be::GroupIndex::get()) {
+            return &index->getUsedGroups();
+        }
+        return nullptr;
+    }
 };
 
 class $modify(SetGroupIDLayer) {
@@ -0,0 +1,192 @@
+#include "Clustering.hpp"
+#include <Geode/utils/ranges.hpp>
+
+constexpr float MINIMUM_DISTANCE = 10; // 1/3 of a block
+// 4 blocks; a typical object ends up in one to four cells, and big clusters
+// don't end up covering too many cells
+constexpr float CELL_SIZE = 120;
+
+float getDistanceBetweenRectsSq(CCRect const& rect1, CCRect const& rect2) {
+    // https://stackoverflow.com/questions/10347085/distance-between-two-rectangles
+    if (rect1.intersectsRect(rect2)) {
+        return 0;
+    }
+
+    CCRect mostLeft = rect1.origin.x < rect2.origin.x ? rect1 : rect2;
+    CCRect mostRight = rect2.origin.x < rect1.origin.x ? rect1 : rect2;
+
+    float xDifference = mostLeft.origin.x == mostRight.origin.x ? 0 : mostRight.origin.x - (mostLeft.origin.x + mostLeft.size.width);
+    xDifference = std::max(0.f, xDifference);
+
+    CCRect upper = rect1.origin.y < rect2.origin.y ? rect1 : rect2;
+    CCRect lower = rect2.origin.y < rect1.origin.y ? rect1 : rect2;
+
+    float yDifference = upper.origin.y == lower.origin.y ? 0 : lower.origin.y - (upper.origin.y + upper.size.height);
+    yDifference = std::max(0.f, yDifference);
+
+    return xDifference * xDifference + yDifference * yDifference;
+}
+
+struct CellRange final {
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+
+    static CellRange from(CCRect const& rect, float padding) {
+        const auto toCell = [](float value) {
+            return static_cast<int>(std::floor(value / CELL_SIZE));
+        };
+        return CellRange {
+            .minX = toCell(std::min(rect.getMinX(), rect.getMaxX()) - padding),
+            .minY = toCell(std::min(rect.getMinY(), rect.getMaxY()) - padding),
+            .maxX = toCell(std::max(rect.getMinX(), rect.getMaxX()) + padding),
+            .maxY = toCell(std::max(rect.getMinY(), rect.getMaxY()) + padding),
+        };
+    }
+};
+
+class ClusterGrid final {
+private:
+    std::unordered_map<uint64_t, std::vector<size_t>> m_cells;
+
+    static uint64_t key(int x, int y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    template <class F>
+    static void forEachCellIn(int minX, int minY, int maxX, int maxY, F&& fun) {
+        for (int x = minX; x <= maxX; x += 1) {
+            for (int y = minY; y <= maxY; y += 1) {
+                fun(key(x, y));
+            }
+        }
+    }
+
+    // Clusters only ever grow, so when one does we only need to visit the
+    // cells that weren't already covered by its previous range. Those form at
+    // most four strips around the old range, which are visited directly so
+    // huge clusters don't need to walk all of their cells on every merge
+    template <class F>
+    static void forEachCell(CellRange const& range, std::optional<CellRange> const& skip, F&& fun) {
+        if (!skip) {
+            return forEachCellIn(range.minX, range.minY, range.maxX, range.maxY, fun);
+        }
+        const auto innerMinX = std::max(range.minX, skip->minX);
+        const auto innerMaxX = std::min(range.maxX, skip->maxX);
+        // Left & right strips over the full height
+        forEachCellIn(range.minX, range.minY, std::min(range.maxX, skip->minX - 1), range.maxY, fun);
+        forEachCellIn(std::max(range.minX, skip->maxX + 1), range.minY, range.maxX, range.maxY, fun);
+        // Bottom & top strips between them
+        forEachCellIn(innerMinX, range.minY, innerMaxX, std::min(range.maxY, skip->minY - 1), fun);
+        forEachCellIn(innerMinX, std::max(range.minY, skip->maxY + 1), innerMaxX, range.maxY, fun);
+    }
+
+public:
+    void clear() {
+        m_cells.clear();
+    }
+
+    void insert(size_t index, CellRange const& range, std::optional<CellRange> const& skip = std::nullopt) {
+        forEachCell(range, skip, [&](uint64_t key) {
+            m_cells[key].push_back(index);
+        });
+    }
+
+    template <class F>
+    void query(CellRange const& range, std::optional<CellRange> const& skip, F&& fun) const {
+        forEachCell(range, skip, [&](uint64_t key) {
+            if (auto cell = m_cells.find(key); cell != m_cells.end()) {
+                for (auto index : cell->second) {
+                    fun(index);
+                }
+            }
+        });
+    }
+};
+
+void cluster(std::vector<Cluster>& clustered) {
+    if (clustered.size() < 2) {
+        return;
+    }
+
+    // Static so we can reuse the allocations between calls
+    static thread_local ClusterGrid GRID {};
+    static thread_local std::vector<size_t> CANDIDATES {};
+
+    GRID.clear();
+    for (size_t i = 0; i < clustered.size(); i += 1) {
+        GRID.insert(i, CellRange::from(clustered[i].rect, 0));
+    }
+
+    // The padding has a little bit of extra room so float rounding at cell
+    // boundaries can never make us miss a close enough cluster
+    constexpr float QUERY_PADDING = MINIMUM_DISTANCE + 1;
+
+    for (size_t i = 0; i < clustered.size(); i += 1) {
+        auto& cluster = clustered[i];
+        if (cluster.merged) continue;
+
+        // Which clusters get merged depends on the order they are checked in
+        // since the cluster rect grows as things are merged into it, so the
+        // candidates are kept in a min-heap and visited in index order just
+        // like a plain linear scan would. Anything behind the cursor has
+        // already been checked and must not be checked again
+        size_t cursor = 0;
+        const auto pushCandidate = [&cursor](size_t j) {
+            if (j >= cursor) {
+                CANDIDATES.push_back(j);
+                std::push_heap(CANDIDATES.begin(), CANDIDATES.end(), std::greater<>());
+            }
+        };
+
+        CANDIDATES.clear();
+        auto storedRange = CellRange::from(cluster.rect, 0);
+        auto queriedRange = CellRange::from(cluster.rect, QUERY_PADDING);
+        GRID.query(queriedRange, std::nullopt, pushCandidate);
+
+        while (!CANDIDATES.empty()) {
+            std::pop_heap(CANDIDATES.begin(), CANDIDATES.end(), std::greater<>());
+            const auto j = CANDIDATES.back();
+            CANDIDATES.pop_back();
+
+            // Same cluster may be found through multiple cells
+            if (j < cursor) continue;
+            cursor = j + 1;
+
+            if (i == j) continue;
+            auto& uncluster = clustered[j];
+            if (uncluster.merged) continue;
+            if (getDistanceBetweenRectsSq(cluster.rect, uncluster.rect) < MINIMUM_DISTANCE * MINIMUM_DISTANCE) {
+                const auto diffMinX = uncluster.rect.getMinX() - cluster.rect.getMinX();
+                if (diffMinX < 0.f) {
+                    cluster.rect.origin.x += diffMinX;
+                    cluster.rect.size.width -= diffMinX;
+                }
+                const auto diffMinY = uncluster.rect.getMinY() - cluster.rect.getMinY();
+                if (diffMinY < 0.f) {
+                    cluster.rect.origin.y += diffMinY;
+                    cluster.rect.size.height -= diffMinY;
+                }
+                cluster.rect.size.width += std::max(0.f, uncluster.rect.getMaxX() - cluster.rect.getMaxX());
+                cluster.rect.size.height += std::max(0.f, uncluster.rect.getMaxY() - cluster.rect.getMaxY());
+                cluster.selected |= uncluster.selected;
+                cluster.objects += 1;
+                uncluster.merged = true;
+
+                // The cluster grew, so it may now be close enough to things
+                // that weren't candidates before, and later clusters need to
+                // be able to find it from its new cells too
+                const auto newStoredRange = CellRange::from(cluster.rect, 0);
+                GRID.insert(i, newStoredRange, storedRange);
+                storedRange = newStoredRange;
+
+                const auto newQueriedRange = CellRange::from(cluster.rect, QUERY_PADDING);
+                GRID.query(newQueriedRange, queriedRange, pushCandidate);
+                queriedRange = newQueriedRange;
+            }
+        }
+    }
+    // Remove all merged clusters from the result
+    ranges::remove(clustered, [](Cluster const& cluster) { return cluster.merged; });
+}
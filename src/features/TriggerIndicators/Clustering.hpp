@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <Geode/cocos/cocoa/CCGeometry.h>
+
+using namespace geode::prelude;
+
+struct Cluster final {
+    CCRect rect;
+    bool selected;
+    size_t objects = 1;
+    bool merged = false;
+};
+
+float getDistanceBetweenRectsSq(CCRect const& rect1, CCRect const& rect2);
+
+/**
+ * Merge all clusters that are closer than 1/3 of a block to each other, and
+ * remove the merged ones from the list. Uses a uniform grid so only nearby
+ * clusters are ever compared, but the result is exactly the same as comparing
+ * every cluster against every other cluster in order
+ */
+void cluster(std::vector<Cluster>& clustered);
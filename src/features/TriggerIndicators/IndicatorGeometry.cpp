@@ -0,0 +1,32 @@
+#include "IndicatorGeometry.hpp"
+#include <numbers>
+
+void IndicatorGeometry::clear() {
+    // This preserves the capacity
+    lines.clear();
+    triangles.clear();
+}
+void IndicatorGeometry::addLine(CCPoint const& from, CCPoint const& to, ccColor4B color) {
+    lines.push_back(IndicatorVertex { from.x, from.y, color });
+    lines.push_back(IndicatorVertex { to.x, to.y, color });
+}
+void IndicatorGeometry::addRect(CCRect const& rect, ccColor4B color) {
+    const auto bl = rect.origin;
+    const auto tr = rect.origin + rect.size;
+    const auto br = ccp(tr.x, bl.y);
+    const auto tl = ccp(bl.x, tr.y);
+    addLine(bl, br, color);
+    addLine(br, tr, color);
+    addLine(tr, tl, color);
+    addLine(tl, bl, color);
+}
+void IndicatorGeometry::addFilledCircle(CCPoint const& center, float radius, unsigned int segments, ccColor4B color) {
+    const auto step = 2 * std::numbers::pi_v<float> / segments;
+    for (unsigned int i = 0; i < segments; i += 1) {
+        const auto a = center + CCPoint::forAngle(step * i) * radius;
+        const auto b = center + CCPoint::forAngle(step * (i + 1)) * radius;
+        triangles.push_back(IndicatorVertex { center.x, center.y, color });
+        triangles.push_back(IndicatorVertex { a.x, a.y, color });
+        triangles.push_back(IndicatorVertex { b.x, b.y, color });
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <Geode/cocos/cocoa/CCGeometry.h>
+
+using namespace geode::prelude;
+
+struct IndicatorVertex final {
+    GLfloat x;
+    GLfloat y;
+    ccColor4B color;
+};
+
+/**
+ * CPU-side indicator geometry. Building this doesn't touch OpenGL, so it can
+ * be done on any thread
+ */
+struct IndicatorGeometry final {
+    std::vector<IndicatorVertex> lines;
+    std::vector<IndicatorVertex> triangles;
+
+    void clear();
+    void addLine(CCPoint const& from, CCPoint const& to, ccColor4B color);
+    void addRect(CCRect const& rect, ccColor4B color);
+    void addFilledCircle(CCPoint const& center, float radius, unsigned int segments, ccColor4B color);
+};
@@ -0,0 +1,395 @@
+#include "IndicatorLayout.hpp"
+#include "Clustering.hpp"
+#include <numbers>
+#include <thread>
+
+using Line = IndicatorLayout::Line;
+
+bool shouldRender(
+    bool triggerSelected, bool targetSelected,
+    bool triggerVisible, bool targetVisible,
+    bool renderTypeOfIndicator
+) {
+    // If the target object or the trigger is selected, always draw indicator
+    if (triggerSelected || targetSelected) {
+        return true;
+    }
+    // Otherwise "show all indicators" must be enabled and either the trigger or 
+    // the target object must be visible
+    if (renderTypeOfIndicator && (triggerVisible || targetVisible)) {
+        return true;
+    }
+    return false;
+}
+
+bool SlotState::operator==(SlotState const& other) const {
+    return groupID == other.groupID &&
+        groupRevision == other.groupRevision &&
+        slotPosition.equals(other.slotPosition) &&
+        dashed == other.dashed &&
+        triggerSelected == other.triggerSelected &&
+        color.r == other.color.r && color.g == other.color.g &&
+        color.b == other.color.b && color.a == other.color.a;
+}
+
+static CCPoint intersectionAtRectOutline(CCRect const& rect, CCPoint const& lineOrigin) {
+    // https://stackoverflow.com/questions/1585525/how-to-find-the-intersection-point-between-a-line-and-a-rectangle
+
+    auto const minX = rect.getMinX();
+    auto const minY = rect.getMinY();
+    auto const maxX = rect.getMaxX();
+    auto const maxY = rect.getMaxY();
+    auto const midX = rect.getMidX();
+	auto const midY = rect.getMidY();
+
+	auto const m = (midY - lineOrigin.y) / (midX - lineOrigin.x);
+
+	if (lineOrigin.x <= midX) { // check "left" side
+		auto const minXy = m * (minX - lineOrigin.x) + lineOrigin.y;
+		if (minY <= minXy && minXy <= maxY) {
+			return ccp(minX, minXy);
+        }
+	}
+
+	if (lineOrigin.x >= midX) { // check "right" side
+		auto const maxXy = m * (maxX - lineOrigin.x) + lineOrigin.y;
+		if (minY <= maxXy && maxXy <= maxY) {
+			return ccp(maxX, maxXy);
+        }
+	}
+
+	if (lineOrigin.y <= midY) { // check "top" side
+		auto const minYx = (minY - lineOrigin.y) / m + lineOrigin.x;
+		if (minX <= minYx && minYx <= maxX) {
+			return ccp(minYx, minY);
+        }
+	}
+
+	if (lineOrigin.y >= midY) { // check "bottom" side
+		auto const maxYx = (maxY - lineOrigin.y) / m + lineOrigin.x;
+		if (minX <= maxYx && maxYx <= maxX)
+			return ccp(maxYx, maxY);
+	}
+
+	// edge case when finding midpoint intersection: m = 0/0 = NaN
+	return ccp(midX, midY);
+}
+
+enum class ViewOverlap {
+    None,
+    Partial,
+    Full,
+};
+static ViewOverlap getViewOverlap(CCRect const& view, CCRect const& bounds) {
+    if (!view.intersectsRect(bounds)) {
+        return ViewOverlap::None;
+    }
+    if (
+        view.getMinX() <= bounds.getMinX() && bounds.getMaxX() <= view.getMaxX() &&
+        view.getMinY() <= bounds.getMinY() && bounds.getMaxY() <= view.getMaxY()
+    ) {
+        return ViewOverlap::Full;
+    }
+    return ViewOverlap::Partial;
+}
+
+void IndicatorLayout::layoutTargets(SlotLayout& slot, std::vector<TargetSnapshot> const& targets) const {
+    auto const& options = *m_options;
+    slot.targets.clear();
+    slot.bounds = CCRectZero;
+
+    // Static so we can reuse the allocation between calls
+    static thread_local std::vector<Cluster> CLUSTERED {};
+    CLUSTERED.clear();
+
+    const auto& slotPosition = slot.state.slotPosition;
+    for (auto const& target : targets) {
+        // Draw indicators between triggers
+        if (target.isTrigger) {
+            slot.targets.push_back(SlotTarget {
+                .line = Line(slotPosition, target.inputSlotPosition),
+                .rect = target.rect,
+                .selected = target.selected,
+                .targetIsTrigger = true,
+            });
+        }
+        // Draw clusters later
+        else {
+            CLUSTERED.push_back(Cluster {
+                .rect = target.rect,
+                .selected = target.selected,
+            });
+        }
+    }
+
+    // Calculate clusters
+    cluster(CLUSTERED);
+
+    for (auto const& cluster : CLUSTERED) {
+        slot.targets.push_back(SlotTarget {
+            .line = Line(
+                slotPosition,
+                options.showClusterOutlines ?
+                    intersectionAtRectOutline(cluster.rect, slotPosition) :
+                    ccp(cluster.rect.getMidX(), cluster.rect.getMidY())
+            ),
+            .rect = cluster.rect,
+            .selected = cluster.selected,
+            .targetIsTrigger = false,
+        });
+    }
+
+    if (slot.targets.empty()) return;
+    constexpr auto INF = std::numeric_limits<float>::infinity();
+    float minX = INF, minY = INF, maxX = -INF, maxY = -INF;
+    for (auto const& target : slot.targets) {
+        minX = std::min({ minX, target.rect.getMinX(), target.rect.getMaxX() });
+        minY = std::min({ minY, target.rect.getMinY(), target.rect.getMaxY() });
+        maxX = std::max({ maxX, target.rect.getMinX(), target.rect.getMaxX() });
+        maxY = std::max({ maxY, target.rect.getMinY(), target.rect.getMaxY() });
+    }
+    slot.bounds = CCRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+bool IndicatorLayout::layoutBatch(SlotLayout& slot, bool targetsChanged, CCRect const& view, bool triggerVisible) const {
+    auto const& options = *m_options;
+    if (!targetsChanged && slot.triggerVisible == triggerVisible) {
+        if (slot.view.equals(view)) {
+            return false;
+        }
+        // If all of the targets were and still are either completely visible 
+        // or completely hidden then moving the view doesn't change anything
+        const auto overlap = getViewOverlap(slot.view, slot.bounds);
+        if (
+            slot.targets.empty() ||
+            (overlap != ViewOverlap::Partial && overlap == getViewOverlap(view, slot.bounds))
+        ) {
+            slot.view = view;
+            return false;
+        }
+    }
+    slot.triggerVisible = triggerVisible;
+    slot.view = view;
+
+    auto& batch = slot.batch;
+    batch.lines.clear();
+    batch.rects.clear();
+    batch.dashed = slot.state.dashed;
+    batch.color = slot.state.color;
+
+    for (auto const& target : slot.targets) {
+        // If any object in the cluster is selected or if the cluster is visible, 
+        // draw indicator line
+        if (!shouldRender(
+            slot.state.triggerSelected, target.selected,
+            triggerVisible, view.intersectsRect(target.rect),
+            target.targetIsTrigger ? options.showTriggerToTrigger : options.showTargets
+        )) {
+            continue;
+        }
+        batch.lines.push_back(std::make_tuple(target.line, target.targetIsTrigger));
+        if (!target.targetIsTrigger && options.showClusterOutlines) {
+            batch.rects.push_back(target.rect);
+        }
+    }
+    return true;
+}
+
+bool IndicatorLayout::update(IndicatorSnapshot const& snapshot, IndicatorGeometry& geometry) {
+    bool changed = false;
+
+    // Nearly everything depends on the options so just start over if they 
+    // have changed
+    if (m_session != snapshot.session || m_options != snapshot.options) {
+        m_slots.clear();
+        m_lastDrawn.clear();
+        m_session = snapshot.session;
+        m_options = snapshot.options;
+        changed = true;
+    }
+    m_updateCount += 1;
+
+    std::swap(m_drawn, m_lastDrawn);
+    m_drawn.clear();
+    for (auto const& slotSnapshot : snapshot.slots) {
+        auto& slot = m_slots[slotSnapshot.id];
+        slot.lastUsedUpdate = m_updateCount;
+
+        bool targetsChanged = false;
+        if (slotSnapshot.targets) {
+            slot.state = slotSnapshot.state;
+            this->layoutTargets(slot, *slotSnapshot.targets);
+            targetsChanged = true;
+        }
+        if (this->layoutBatch(slot, targetsChanged, snapshot.view, slotSnapshot.triggerVisible)) {
+            changed = true;
+        }
+        if (!slot.batch.lines.empty() || !slot.batch.rects.empty()) {
+            m_drawn.push_back(&slot.batch);
+        }
+    }
+
+    // Forget about slots that no longer exist
+    std::erase_if(m_slots, [this](auto const& pair) {
+        return pair.second.lastUsedUpdate != m_updateCount;
+    });
+
+    const auto sameNode = [](CCPoint const& a, CCPoint const& b) {
+        return a.equals(b);
+    };
+    if (
+        m_drawn != m_lastDrawn ||
+        !std::ranges::equal(snapshot.nodes, m_nodes, sameNode)
+    ) {
+        changed = true;
+    }
+    m_nodes = snapshot.nodes;
+
+    if (!changed) {
+        return false;
+    }
+    this->buildGeometry(geometry);
+    return true;
+}
+
+static void batchDashedLine(IndicatorGeometry& geometry, Line const& line, float length, ccColor4B color) {
+    auto isAtEnd = +[](Line const& line, CCPoint const& pos) {
+        return line.from.x == line.to.x ?
+            fabsf(pos.y - line.from.y) >= fabsf(line.to.y - line.from.y) :
+            fabsf(pos.x - line.from.x) >= fabsf(line.to.x - line.from.x);
+    };
+    auto angle = atan2f(line.to.y - line.from.y, line.to.x - line.from.x);
+    auto add = ccp(length * cosf(angle), length * sinf(angle));
+    auto pos = line.from;
+    while (!isAtEnd(line, pos)) {
+        if (isAtEnd(line, pos + add)) {
+            geometry.addLine(pos, line.to, color);
+            break;
+        }
+        else {
+            geometry.addLine(pos, pos + add, color);
+            pos += add * 2;
+        }
+    }
+}
+void IndicatorLayout::buildGeometry(IndicatorGeometry& geometry) const {
+    auto const& options = *m_options;
+    geometry.clear();
+    for (auto batch : m_drawn) {
+        const auto pickWhichToDraw = [&](Line const& line, bool arrowTicks) {
+            if (batch->dashed) {
+                batchDashedLine(geometry, line, 10, batch->color);
+            }
+            else {
+                geometry.addLine(line.from, line.to, batch->color);
+            }
+            if (arrowTicks) {
+                const auto angle = line.getAngle();
+                const auto tickLength = 10;
+                const auto tickAngle = std::numbers::pi_v<float> * .75f;
+                geometry.addLine(line.to, line.to + CCPoint::forAngle(angle - tickAngle) * tickLength, batch->color);
+                geometry.addLine(line.to, line.to + CCPoint::forAngle(angle + tickAngle) * tickLength, batch->color);
+            }
+        };
+
+        for (auto const& [line, targetIsTrigger] : batch->lines) {
+            if (options.blockyLines) {
+                constexpr float MIN_TRIGGER_PROT = 15;
+                
+                const float minProtFromTarget = targetIsTrigger ? MIN_TRIGGER_PROT : 0;
+                const auto delt = line.to - line.from;
+
+                // Check if we can just draw a snakey line
+                if (delt.x > MIN_TRIGGER_PROT + minProtFromTarget) {
+                    const auto midPoint1 = ccp(line.from.x + delt.x / 2, line.from.y);
+                    const auto midPoint2 = ccp(midPoint1.x,              line.to.y);
+                    pickWhichToDraw(Line(line.from, midPoint1), false);
+                    pickWhichToDraw(Line(midPoint1, midPoint2), false);
+                    pickWhichToDraw(Line(midPoint2, line.to),   options.arrowHeads);
+                }
+                // Otherwise we gotta snake a lil more
+                else {
+                    const auto midPoint1 = ccp(line.from.x + MIN_TRIGGER_PROT,line.from.y);
+                    const auto midPoint2 = ccp(midPoint1.x,                   line.to.y - delt.y / 2);
+                    const auto midPoint3 = ccp(line.to.x - minProtFromTarget, midPoint2.y);
+                    const auto midPoint4 = ccp(midPoint3.x,                   line.to.y);
+                    pickWhichToDraw(Line(line.from, midPoint1), false);
+                    pickWhichToDraw(Line(midPoint1, midPoint2), false);
+                    pickWhichToDraw(Line(midPoint2, midPoint3), false);
+                    pickWhichToDraw(Line(midPoint3, midPoint4), false);
+                    pickWhichToDraw(Line(midPoint4, line.to),   options.arrowHeads);
+                }
+            }
+            else {
+                pickWhichToDraw(line, options.arrowHeads);
+            }
+        }
+
+        for (auto const& rect : batch->rects) {
+            geometry.addRect(rect, batch->color);
+        }
+    }
+    for (auto const& node : m_nodes) {
+        // todo: different shapes
+        geometry.addFilledCircle(node, 4, 10, ccc4(0, 0, 0, 255));
+        geometry.addFilledCircle(node, 3, 10, ccc4(255, 255, 255, 255));
+    }
+}
+
+
+IndicatorLayoutWorker::IndicatorLayoutWorker() {
+    // The worker lives for as long as the game does, so it's never joined
+    std::thread(&IndicatorLayoutWorker::run, this).detach();
+}
+
+void IndicatorLayoutWorker::run() {
+    while (true) {
+        IndicatorSnapshot snapshot;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_pending.has_value(); });
+            snapshot = std::move(*m_pending);
+            m_pending.reset();
+            m_working = true;
+        }
+        const bool changed = m_layout.update(snapshot, m_building);
+        {
+            std::unique_lock lock(m_mutex);
+            if (changed) {
+                std::swap(m_building, m_back);
+                m_backSession = snapshot.session;
+            }
+            m_working = false;
+        }
+    }
+}
+
+IndicatorLayoutWorker* IndicatorLayoutWorker::get() {
+    static auto inst = new IndicatorLayoutWorker();
+    return inst;
+}
+
+bool IndicatorLayoutWorker::isIdle() {
+    std::unique_lock lock(m_mutex);
+    return !m_pending && !m_working;
+}
+void IndicatorLayoutWorker::submit(IndicatorSnapshot&& snapshot) {
+    {
+        std::unique_lock lock(m_mutex);
+        m_pending = std::move(snapshot);
+    }
+    m_condition.notify_one();
+}
+bool IndicatorLayoutWorker::swapResult(size_t session, IndicatorGeometry& front) {
+    std::unique_lock lock(m_mutex);
+    if (!m_backSession) {
+        return false;
+    }
+    const bool sameSession = *m_backSession == session;
+    m_backSession.reset();
+    if (!sameSession) {
+        return false;
+    }
+    std::swap(front, m_back);
+    return true;
+}
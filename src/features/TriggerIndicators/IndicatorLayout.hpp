@@ -0,0 +1,158 @@
+#pragma once
+
+#include "IndicatorGeometry.hpp"
+#include <condition_variable>
+#include <mutex>
+
+struct IndicatorLayoutOptions final {
+    bool showTriggerToTrigger;
+    bool showTargets;
+    bool showClusterOutlines;
+    bool blockyLines;
+    bool arrowHeads;
+
+    bool operator==(IndicatorLayoutOptions const&) const = default;
+};
+
+bool shouldRender(
+    bool triggerSelected, bool targetSelected,
+    bool triggerVisible, bool targetVisible,
+    bool renderTypeOfIndicator
+);
+
+// Everything that the targets of a slot depend on, except for where the view is
+struct SlotState final {
+    int groupID;
+    uint32_t groupRevision;
+    CCPoint slotPosition;
+    bool dashed;
+    bool triggerSelected;
+    ccColor4B color;
+
+    bool operator==(SlotState const& other) const;
+};
+
+// Copy of a target object taken on the main thread
+struct TargetSnapshot final {
+    CCRect rect;
+    // Where the line should end if the target is a trigger
+    CCPoint inputSlotPosition;
+    bool selected;
+    bool isTrigger;
+};
+struct SlotSnapshot final {
+    // Identifies the same slot between snapshots
+    uint64_t id;
+    SlotState state;
+    bool triggerVisible;
+    // Only taken if the state of the slot has changed since the last snapshot
+    std::optional<std::vector<TargetSnapshot>> targets;
+};
+struct IndicatorSnapshot final {
+    // Results are thrown away if they are for a different editor than the
+    // current one
+    size_t session;
+    IndicatorLayoutOptions options;
+    CCRect view;
+    std::vector<SlotSnapshot> slots;
+    std::vector<CCPoint> nodes;
+};
+
+/**
+ * Turns indicator snapshots into geometry. Only the slots that have new
+ * targets or whose visibility changed are laid out again. This never touches
+ * any game objects, so it can be run on any thread
+ */
+class IndicatorLayout final {
+public:
+    struct Line final {
+        CCPoint from;
+        CCPoint to;
+
+        Line(CCPoint const& from, CCPoint const& to) : from(from), to(to) {}
+        float getAngle() const {
+            return (to - from).getAngle();
+        }
+    };
+    struct LineBatch final {
+        std::vector<std::tuple<Line, bool>> lines;
+        std::vector<CCRect> rects;
+        bool dashed;
+        ccColor4B color;
+    };
+    struct SlotTarget final {
+        Line line;
+        CCRect rect;
+        bool selected;
+        bool targetIsTrigger;
+    };
+    struct SlotLayout final {
+        SlotState state;
+        // Every trigger and cluster this slot could draw a line to
+        std::vector<SlotTarget> targets;
+        // Rect that contains all of the targets
+        CCRect bounds;
+
+        // The lines that are actually drawn depend on what is visible
+        bool triggerVisible = false;
+        CCRect view;
+        LineBatch batch;
+        size_t lastUsedUpdate = 0;
+    };
+
+protected:
+    std::unordered_map<uint64_t, SlotLayout> m_slots;
+    std::optional<IndicatorLayoutOptions> m_options;
+    std::optional<size_t> m_session;
+    size_t m_updateCount = 0;
+    std::vector<LineBatch const*> m_drawn;
+    std::vector<LineBatch const*> m_lastDrawn;
+    std::vector<CCPoint> m_nodes;
+
+    void layoutTargets(SlotLayout& slot, std::vector<TargetSnapshot> const& targets) const;
+    bool layoutBatch(SlotLayout& slot, bool targetsChanged, CCRect const& view, bool triggerVisible) const;
+    void buildGeometry(IndicatorGeometry& geometry) const;
+
+public:
+    /**
+     * Update the layout from a snapshot. Returns true and rebuilds `geometry`
+     * if anything changed, otherwise leaves it untouched
+     */
+    bool update(IndicatorSnapshot const& snapshot, IndicatorGeometry& geometry);
+};
+
+/**
+ * Runs `IndicatorLayout` on a background thread so the editor never has to
+ * wait for indicators to be laid out
+ */
+class IndicatorLayoutWorker final {
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::optional<IndicatorSnapshot> m_pending;
+    bool m_working = false;
+    // Finished geometry waiting to be swapped in by the main thread
+    IndicatorGeometry m_back;
+    std::optional<size_t> m_backSession;
+    // Only ever touched by the worker thread
+    IndicatorLayout m_layout;
+    IndicatorGeometry m_building;
+
+    IndicatorLayoutWorker();
+    void run();
+
+public:
+    static IndicatorLayoutWorker* get();
+
+    /**
+     * Whether the worker has finished everything that was submitted to it
+     */
+    bool isIdle();
+    void submit(IndicatorSnapshot&& snapshot);
+    /**
+     * If there is a finished result for `session`, swap it with `front` and
+     * return true. The old contents of `front` are reused as the next back
+     * buffer
+     */
+    bool swapResult(size_t session, IndicatorGeometry& front);
+};
@@ -0,0 +1,110 @@
+#include "IndicatorRenderer.hpp"
+#include <Geode/Loader.hpp>
+
+// Bumped every time the GL context is recreated. Only ever touched on the 
+// main thread
+static size_t GL_CONTEXT = 0;
+
+#ifdef GEODE_IS_ANDROID
+// Android throws away the GL context when the game is sent to the background 
+// and posts this once it has made a new one, after reloading its own textures 
+// and shaders. Buffer names from the old context are meaningless in the new one
+class GLContextObserver final : public CCObject {
+public:
+    void onContextRecreated(CCObject*) {
+        GL_CONTEXT += 1;
+    }
+};
+
+$execute {
+    CCNotificationCenter::sharedNotificationCenter()->addObserver(
+        new GLContextObserver(),
+        callfuncO_selector(GLContextObserver::onContextRecreated),
+        "event_come_to_foreground", nullptr
+    );
+}
+#endif
+
+IndicatorRenderer::~IndicatorRenderer() {
+    // The buffer went away with its context, and its name may have been 
+    // reused by someone else in the new one
+    if (m_buffer && !this->isContextLost()) {
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+bool IndicatorRenderer::isContextLost() const {
+    return m_buffer && m_context != GL_CONTEXT;
+}
+void IndicatorRenderer::upload(IndicatorGeometry const& geometry) {
+    if (this->isContextLost()) {
+        m_buffer = 0;
+    }
+    if (!m_buffer) {
+        glGenBuffers(1, &m_buffer);
+        m_context = GL_CONTEXT;
+    }
+    auto const& lines = geometry.lines;
+    auto const& triangles = geometry.triangles;
+    m_uploadedLineVertices = lines.size();
+    m_uploadedTriangleVertices = triangles.size();
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    // Lines first, then triangles, in the same buffer
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        (lines.size() + triangles.size()) * sizeof(IndicatorVertex),
+        nullptr, GL_DYNAMIC_DRAW
+    );
+    if (!lines.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, lines.size() * sizeof(IndicatorVertex), lines.data());
+    }
+    if (!triangles.empty()) {
+        glBufferSubData(
+            GL_ARRAY_BUFFER,
+            lines.size() * sizeof(IndicatorVertex),
+            triangles.size() * sizeof(IndicatorVertex),
+            triangles.data()
+        );
+    }
+    // Cocos draws everything else from client-side arrays
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void IndicatorRenderer::draw(GLfloat lineWidth) const {
+    if (!m_buffer || this->isContextLost() || (m_uploadedLineVertices == 0 && m_uploadedTriangleVertices == 0)) {
+        return;
+    }
+
+    auto shader = CCShaderCache::sharedShaderCache()->programForKey(kCCShader_PositionColor);
+    shader->use();
+    shader->setUniformsForBuiltins();
+    ccGLEnableVertexAttribs(kCCVertexAttribFlag_Position | kCCVertexAttribFlag_Color);
+    ccGLBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    glVertexAttribPointer(
+        kCCVertexAttrib_Position, 2, GL_FLOAT, GL_FALSE, sizeof(IndicatorVertex),
+        reinterpret_cast<GLvoid*>(offsetof(IndicatorVertex, x))
+    );
+    glVertexAttribPointer(
+        kCCVertexAttrib_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(IndicatorVertex),
+        reinterpret_cast<GLvoid*>(offsetof(IndicatorVertex, color))
+    );
+
+    if (m_uploadedLineVertices) {
+        glLineWidth(lineWidth);
+        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(m_uploadedLineVertices));
+        CC_INCREMENT_GL_DRAWS(1);
+    }
+    if (m_uploadedTriangleVertices) {
+        glDrawArrays(
+            GL_TRIANGLES,
+            static_cast<GLint>(m_uploadedLineVertices),
+            static_cast<GLsizei>(m_uploadedTriangleVertices)
+        );
+        CC_INCREMENT_GL_DRAWS(1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "IndicatorGeometry.hpp"
+
+/**
+ * Keeps all indicator geometry in one persistent vertex buffer. The geometry
+ * is only uploaded to the GPU when it actually changes; otherwise drawing
+ * everything is just two draw calls, one for the lines and one for the filled
+ * shapes
+ */
+class IndicatorRenderer final {
+protected:
+    GLuint m_buffer = 0;
+    // Which GL context `m_buffer` was created in
+    size_t m_context = 0;
+    size_t m_uploadedLineVertices = 0;
+    size_t m_uploadedTriangleVertices = 0;
+
+public:
+    IndicatorRenderer() = default;
+    IndicatorRenderer(IndicatorRenderer const&) = delete;
+    IndicatorRenderer& operator=(IndicatorRenderer const&) = delete;
+    ~IndicatorRenderer();
+
+    /**
+     * Whether the GL context the buffer was created in has been destroyed 
+     * since, so the geometry has to be uploaded again before it can be drawn
+     */
+    bool isContextLost() const;
+    void upload(IndicatorGeometry const& geometry);
+    void draw(GLfloat lineWidth) const;
+};
@@ -0,0 +1,100 @@
+#include "Invalidation.hpp"
+#include <Geode/modify/GameObject.hpp>
+#include <Geode/modify/EditorUI.hpp>
+#include <Geode/modify/LevelEditorLayer.hpp>
+#include <Geode/utils/cocos.hpp>
+
+// Group IDs go from 1 to 9999
+static std::array<uint32_t, 10000> GROUP_REVISIONS {};
+
+uint32_t getGroupRevision(int groupID) {
+    if (groupID <= 0 || groupID >= static_cast<int>(GROUP_REVISIONS.size())) {
+        return 0;
+    }
+    return GROUP_REVISIONS[groupID];
+}
+void invalidateGroup(int groupID) {
+    if (groupID <= 0 || groupID >= static_cast<int>(GROUP_REVISIONS.size())) {
+        return;
+    }
+    GROUP_REVISIONS[groupID] += 1;
+}
+void invalidateGroupsOf(GameObject* obj) {
+    if (!obj || !obj->m_groups) {
+        return;
+    }
+    for (short i = 0; i < obj->m_groupCount; i += 1) {
+        invalidateGroup(obj->m_groups->at(i));
+    }
+}
+
+// These are called a lot, so they only ever bump a couple of counters
+class $modify(GameObject) {
+    $override
+    void setPosition(CCPoint const& pos) {
+        GameObject::setPosition(pos);
+        invalidateGroupsOf(this);
+    }
+    $override
+    void setScale(float scale) {
+        GameObject::setScale(scale);
+        invalidateGroupsOf(this);
+    }
+    $override
+    void setScaleX(float scale) {
+        GameObject::setScaleX(scale);
+        invalidateGroupsOf(this);
+    }
+    $override
+    void setScaleY(float scale) {
+        GameObject::setScaleY(scale);
+        invalidateGroupsOf(this);
+    }
+};
+
+class $modify(LevelEditorLayer) {
+    $override
+    void addToGroup(GameObject* obj, int group, bool p2) {
+        LevelEditorLayer::addToGroup(obj, group, p2);
+        invalidateGroup(group);
+    }
+    $override
+    void removeFromGroup(GameObject* obj, int group) {
+        LevelEditorLayer::removeFromGroup(obj, group);
+        invalidateGroup(group);
+    }
+    $override
+    void removeObject(GameObject* obj, bool undo) {
+        invalidateGroupsOf(obj);
+        LevelEditorLayer::removeObject(obj, undo);
+    }
+};
+
+class $modify(EditorUI) {
+    $override
+    void selectObject(GameObject* obj, bool filter) {
+        EditorUI::selectObject(obj, filter);
+        invalidateGroupsOf(obj);
+    }
+    $override
+    void selectObjects(CCArray* objs, bool ignoreFilters) {
+        EditorUI::selectObjects(objs, ignoreFilters);
+        for (auto obj : CCArrayExt<GameObject*>(objs)) {
+            invalidateGroupsOf(obj);
+        }
+    }
+    $override
+    void deselectObject(GameObject* obj) {
+        EditorUI::deselectObject(obj);
+        invalidateGroupsOf(obj);
+    }
+    $override
+    void deselectAll() {
+        // Figure out what was selected before it gets cleared
+        invalidateGroupsOf(m_selectedObject);
+        for (auto obj : CCArrayExt<GameObject*>(m_selectedObjects)) {
+            invalidateGroupsOf(obj);
+        }
+        EditorUI::deselectAll();
+    }
+};
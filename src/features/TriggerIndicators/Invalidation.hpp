@@ -0,0 +1,15 @@
+#pragma once
+
+#include <Geode/binding/GameObject.hpp>
+
+using namespace geode::prelude;
+
+/**
+ * Get the current revision of a group. The revision changes every time an
+ * object in the group is moved, scaled, selected or deselected, or when an
+ * object is added to or removed from the group, so anything computed from the
+ * objects in a group can be cached for as long as its revision stays the same
+ */
+uint32_t getGroupRevision(int groupID);
+void invalidateGroup(int groupID);
+void invalidateGroupsOf(GameObject* obj);
@@ -0,0 +1,345 @@
+#include <Geode/modify/DrawGridLayer.hpp>
+#include <Geode/binding/LevelEditorLayer.hpp>
+#include <Geode/binding/EditorUI.hpp>
+#include <Geode/binding/GameObject.hpp>
+#include <Geode/binding/EffectGameObject.hpp>
+#include <Geode/binding/TriggerControlGameObject.hpp>
+#include <Geode/utils/cocos.hpp>
+#include <Geode/ui/BasedButtonSprite.hpp>
+#include <Geode/utils/ranges.hpp>
+#include <features/supporters/Pro.hpp>
+#include <utils/ObjectIDs.hpp>
+#include <utils/Editor.hpp>
+#include "Invalidation.hpp"
+#include "IndicatorLayout.hpp"
+#include "IndicatorRenderer.hpp"
+
+using namespace geode::prelude;
+
+static ccColor3B getTriggerColor(EffectGameObject* trigger) {
+    using namespace object_ids;
+    switch (trigger->m_objectID) {
+        case MOVE_TRIGGER: case AREA_MOVE_TRIGGER: case EDIT_AREA_MOVE_TRIGGER:
+            return ccc3(255, 0, 255);
+
+        case ROTATE_TRIGGER: case AREA_ROTATE_TRIGGER: case EDIT_AREA_ROTATE_TRIGGER:
+            return ccc3(127, 127, 255);
+        
+        case SCALE_TRIGGER: case AREA_SCALE_TRIGGER: case EDIT_AREA_SCALE_TRIGGER:
+            return ccc3(63, 191, 255);
+        
+        case PULSE_TRIGGER: case AREA_TINT_TRIGGER: case EDIT_AREA_TINT_TRIGGER:
+            return ccc3(255, 255, 0);
+        
+        case ALPHA_TRIGGER: case AREA_FADE_TRIGGER: case EDIT_AREA_FADE_TRIGGER:
+            return ccc3(0, 255, 255);
+        
+        case TOGGLE_TRIGGER: {
+            if (trigger->m_activateGroup) {
+                return ccc3(0, 255, 127);
+            }
+            return ccc3(255, 63, 63);
+        }
+        case SPAWN_TRIGGER:  return ccc3(35, 204, 127);
+        case FOLLOW_TRIGGER: return ccc3(255, 127, 127);
+        
+        case ADVANCED_FOLLOW_TRIGGER: case EDIT_ADVANCED_FOLLOW_TRIGGER: case RE_TARGET_ADVANCED_FOLLOW_TRIGGER:
+            return ccc3(204, 255, 199);
+        
+        case ANIMATE_TRIGGER:           return ccc3(255, 183, 0);
+        case FOLLOW_PLAYER_Y_TRIGGER:   return ccc3(255, 255, 127);
+        case CHANGE_BG_TRIGGER:         return ccc3(127, 255, 255);
+        case CHANGE_GROUND_TRIGGER:     return ccc3(255, 255, 127);
+        case CHANGE_MIDGROUND_TRIGGER:  return ccc3(255, 127, 255);
+        case TOUCH_TRIGGER:             return ccc3(0, 137, 178);
+        case COUNT_TRIGGER:             return ccc3(255, 183, 252);
+        case INSTANT_COUNT_TRIGGER:     return ccc3(255, 135, 255);
+        case PICKUP_TRIGGER:            return ccc3(255, 109, 0);
+        case RANDOM_TRIGGER:            return ccc3(63, 127, 255);
+
+        case STOP_TRIGGER: {
+            switch (static_cast<TriggerControlGameObject*>(trigger)->m_customTriggerValue) {
+                default:
+                case GJActionCommand::Stop: return ccc3(163, 0, 86);
+                case GJActionCommand::Pause: return ccc3(255, 63, 0);
+                case GJActionCommand::Resume: return ccc3(63, 255, 0);
+            }
+        }
+
+        case ADVANCED_RANDOM_TRIGGER: case SEQUENCE_TRIGGER:
+            return ccc3(165, 94, 255);
+
+        case SPAWN_PARTICLE_TRIGGER: return ccc3(150, 150, 150);
+        case RESET_TRIGGER:          return ccc3(255, 100, 0);
+        case CAMERA_ZOOM_TRIGGER:    return ccc3(127, 127, 255);
+        case CAMERA_STATIC_TRIGGER:  return ccc3(255, 127, 127);
+        case CAMERA_ROTATE_TRIGGER:  return ccc3(255, 245, 0);
+        case CAMERA_EDGE_TRIGGER:    return ccc3(0, 199, 255);
+        case CAMERA_MODE_TRIGGER:    return ccc3(191, 255, 0);
+        case COLLISION_TRIGGER:      return ccc3(83, 66, 250);
+        case TIME_WARP_TRIGGER:      return ccc3(153, 127, 153);
+        case BG_SPEED_TRIGGER:       return ccc3(127, 255, 255);
+        case ON_DEATH_TRIGGER:       return ccc3(204, 101, 101);
+        case PLAYER_CONTROL_TRIGGER: return ccc3(101, 255, 255);
+
+        case MIDGROUND_SETUP_TRIGGER: case MIDGROUND_SPEED_TRIGGER:
+            return ccc3(255, 127, 255);
+
+        case CAMERA_OFFSET_TRIGGER: case CAMERA_GP_OFFSET_TRIGGER:
+            return ccc3(127, 255, 127);
+        
+        default:
+            return ccWHITE;
+    }
+}
+
+static bool usesDashedLine(be::SlotType type) {
+    return type == be::SlotType::Center;
+}
+
+enum class TriggerIndicatorColors {
+    None,
+    SelectedOnly,
+    All,
+};
+static TriggerIndicatorColors parseTriggerIndicatorColors(std::string const& str) {
+    switch (hash(str)) {
+        case hash("None"): return TriggerIndicatorColors::None;
+        default:
+        case hash("Selected Only"): return TriggerIndicatorColors::SelectedOnly;
+        case hash("All"): return TriggerIndicatorColors::All;
+    }
+}
+
+// This does not take rotation into account but I'm assuming `boundingBox` is 
+// too expensive
+// If I'm wrong I can just use that
+static CCRect getObjectRect(GameObject* obj) {
+    const auto pos = obj->getPosition();
+    const auto size = obj->getScaledContentSize();
+    const auto anchor = obj->getAnchorPoint();
+    return CCRect(
+        ccp(pos.x - size.width * anchor.x, pos.y - size.height * anchor.y),
+        size
+    );
+}
+
+struct IndicatorOptions final {
+    IndicatorLayoutOptions layout;
+    GLfloat lineThickness;
+    GLubyte lineOpacity;
+    TriggerIndicatorColors colors;
+
+    bool operator==(IndicatorOptions const&) const = default;
+};
+
+static size_t NEXT_SESSION = 0;
+
+class $modify(TriggerIndicatorsLayer, DrawGridLayer) {
+    struct Fields {
+        size_t session = NEXT_SESSION++;
+        IndicatorRenderer renderer;
+        IndicatorGeometry front;
+        // What the layout worker has last been told about
+        std::optional<IndicatorOptions> submittedOptions;
+        std::unordered_map<uint64_t, SlotState> submittedStates;
+        std::vector<std::tuple<uint64_t, bool>> submittedSlots;
+        CCRect submittedView;
+        std::vector<CCPoint> submittedNodes;
+    };
+
+    void snapshotSlot(
+        IndicatorSnapshot& snapshot, bool& changed,
+        EffectGameObject* trigger, size_t slotIndex, int groupID,
+        CCPoint const& slotPosition, bool dashedLine,
+        IndicatorOptions const& options,
+        ccColor4B lineColor, CCRect const& objLayerRect
+    ) {
+        const auto id = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(trigger)) << 1) | slotIndex;
+        auto slot = SlotSnapshot {
+            .id = id,
+            .state = SlotState {
+                .groupID = groupID,
+                .groupRevision = getGroupRevision(groupID),
+                .slotPosition = slotPosition,
+                .dashed = dashedLine,
+                .triggerSelected = trigger->m_isSelected,
+                .color = lineColor,
+            },
+            .triggerVisible = objLayerRect.intersectsRect(getObjectRect(trigger)),
+            .targets = std::nullopt,
+        };
+
+        // Only copy the targets if the worker doesn't already have them
+        auto submitted = m_fields->submittedStates.find(id);
+        if (submitted == m_fields->submittedStates.end() || !(submitted->second == slot.state)) {
+            changed = true;
+            auto& targets = slot.targets.emplace();
+            if (auto objs = be::getObjectsFromGroupDict(m_editorLayer->m_groupDict, groupID)) {
+                for (auto obj : CCArrayExt<GameObject*>(objs)) {
+                    if (object_ids::isTriggerID(obj->m_objectID)) {
+                        const auto effObj = static_cast<EffectGameObject*>(obj);
+                        targets.push_back(TargetSnapshot {
+                            .rect = getObjectRect(obj),
+                            .inputSlotPosition = be::getTriggerSlots(effObj).first.calculateSlotPosition(effObj, 0),
+                            .selected = obj->m_isSelected,
+                            .isTrigger = true,
+                        });
+                    }
+                    else if (options.layout.showTargets || obj->m_isSelected || trigger->m_isSelected) {
+                        targets.push_back(TargetSnapshot {
+                            .rect = getObjectRect(obj),
+                            .inputSlotPosition = CCPointZero,
+                            .selected = obj->m_isSelected,
+                            .isTrigger = false,
+                        });
+                    }
+                }
+            }
+        }
+        snapshot.slots.push_back(std::move(slot));
+    }
+
+    std::optional<IndicatorSnapshot> takeSnapshot(IndicatorOptions const& options) {
+        bool changed = false;
+        if (m_fields->submittedOptions != options) {
+            m_fields->submittedOptions = options;
+            m_fields->submittedStates.clear();
+            changed = true;
+        }
+
+        // Calculate where the visible part of the view is on the object layer 
+        // so we can just check if the object's position is within that rect 
+        // without needing to transform it to world space first
+        const auto objLayerRect = CCRect(
+            m_editorLayer->m_objectLayer->convertToNodeSpace(CCPointZero),
+            CCDirector::get()->getWinSize() / m_editorLayer->m_objectLayer->getScale()
+        );
+
+        auto snapshot = IndicatorSnapshot {
+            .session = m_fields->session,
+            .options = options.layout,
+            .view = objLayerRect,
+            .slots = {},
+            .nodes = {},
+        };
+
+        for (auto trigger : CCArrayExt<EffectGameObject*>(m_effectGameObjects)) {
+            auto [inputSlots, outputSlots] = be::getTriggerSlots(trigger);
+            auto const triggerColor = options.colors != TriggerIndicatorColors::None ? 
+                std::optional(to4B(getTriggerColor(trigger), options.lineOpacity)) : 
+                std::nullopt;
+            
+            auto const triggerVisible = shouldRender(
+                trigger->m_isSelected, false,
+                objLayerRect.intersectsRect(getObjectRect(trigger)), false,
+                true
+            );
+        
+            if (outputSlots.targetGroupID) {
+                auto const slotPos = outputSlots.calculateSlotPosition(trigger, 0);
+                this->snapshotSlot(
+                    snapshot, changed,
+                    trigger, 0, trigger->m_targetGroupID,
+                    slotPos,
+                    usesDashedLine(*outputSlots.targetGroupID),
+                    options,
+                    triggerColor.value_or(ccc4(0, 255, 0, options.lineOpacity)),
+                    objLayerRect
+                );
+                if (triggerVisible) {
+                    snapshot.nodes.push_back(slotPos);
+                }
+            }
+            if (outputSlots.centerGroupID) {
+                auto const slotPos = outputSlots.calculateSlotPosition(trigger, 1);
+                this->snapshotSlot(
+                    snapshot, changed,
+                    trigger, 1, trigger->m_centerGroupID,
+                    slotPos, usesDashedLine(*outputSlots.centerGroupID),
+                    options,
+                    triggerColor.value_or(ccc4(0, 255, 255, options.lineOpacity)),
+                    objLayerRect
+                );
+                if (triggerVisible) {
+                    snapshot.nodes.push_back(slotPos);
+                }
+            }
+            if (inputSlots.targetGroupID) {
+                if (triggerVisible) {
+                    snapshot.nodes.push_back(inputSlots.calculateSlotPosition(trigger, 0));
+                }
+            }
+        }
+
+        // Even if no targets changed, triggers may have been deleted, moved 
+        // in or out of view, or the view itself may have moved
+        if (!changed) {
+            const auto sameSlot = [](auto const& submitted, SlotSnapshot const& slot) {
+                return std::get<0>(submitted) == slot.id && std::get<1>(submitted) == slot.triggerVisible;
+            };
+            const auto sameNode = [](CCPoint const& a, CCPoint const& b) {
+                return a.equals(b);
+            };
+            changed =
+                !m_fields->submittedView.equals(objLayerRect) ||
+                !std::ranges::equal(m_fields->submittedSlots, snapshot.slots, sameSlot) ||
+                !std::ranges::equal(m_fields->submittedNodes, snapshot.nodes, sameNode);
+        }
+        if (!changed) {
+            return std::nullopt;
+        }
+
+        m_fields->submittedStates.clear();
+        m_fields->submittedSlots.clear();
+        for (auto const& slot : snapshot.slots) {
+            m_fields->submittedStates.emplace(slot.id, slot.state);
+            m_fields->submittedSlots.push_back(std::make_tuple(slot.id, slot.triggerVisible));
+        }
+        m_fields->submittedView = objLayerRect;
+        m_fields->submittedNodes = snapshot.nodes;
+        return snapshot;
+    }
+
+    $override
+    void draw() {
+        DrawGridLayer::draw();
+
+        if (!HAS_PRO() || !Mod::get()->getSavedValue<bool>("show-trigger-indicators", true)) {
+            return;
+        }
+
+        #define GET_VIEW_TAB(id) Mod::get()->template getSavedValue<bool>(id)
+        #define GET_SETTING(ty, id) Mod::get()->template getSettingValue<ty>(id)
+
+        const auto options = IndicatorOptions {
+            .layout = IndicatorLayoutOptions {
+                .showTriggerToTrigger = GET_VIEW_TAB("trigger-indicators-trigger-to-trigger"),
+                .showTargets = GET_VIEW_TAB("trigger-indicators-show-all"),
+                .showClusterOutlines = GET_VIEW_TAB("trigger-indicators-cluster-outlines"),
+                .blockyLines = GET_VIEW_TAB("trigger-indicators-blocky"),
+                .arrowHeads = GET_SETTING(bool, "trigger-indicator-tickheads"),
+            },
+            .lineThickness = static_cast<GLfloat>(GET_SETTING(float, "trigger-indicator-thickness")),
+            .lineOpacity = static_cast<GLubyte>(GET_SETTING(float, "trigger-indicator-opacity") * 255),
+            .colors = parseTriggerIndicatorColors(GET_SETTING(std::string, "trigger-indicator-colors")),
+        };
+
+        // Layout happens on a worker thread; swap in its latest result if 
+        // there is one and give it a new snapshot once it's done, but never 
+        // wait for it
+        auto worker = IndicatorLayoutWorker::get();
+        if (
+            worker->swapResult(m_fields->session, m_fields->front) ||
+            m_fields->renderer.isContextLost()
+        ) {
+            m_fields->renderer.upload(m_fields->front);
+        }
+        if (worker->isIdle()) {
+            if (auto snapshot = this->takeSnapshot(options)) {
+                worker->submit(std::move(*snapshot));
+            }
+        }
+        m_fields->renderer.draw(options.lineThickness);
+    }
+};
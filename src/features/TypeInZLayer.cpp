@@ -7,9 +7,22 @@
 #include <Geode/binding/GameManager.hpp>
 #include <Geode/binding/GameObject.hpp>
 #include <utils/Editor.hpp>
+#include <utils/UsedIDs.hpp>
 
 using namespace geode::prelude;
 
+struct EditorLayerSource final {
+    using ValueType = short;
+
+    static constexpr short MIN_VALUE = 0;
+    static constexpr short MAX_VALUE = std::numeric_limits<short>::max();
+
+    static void getUsedIDs(GameObject* obj, std::vector<short>& used) {
+        used.push_back(obj->m_editorLayer);
+        used.push_back(obj->m_editorLayer2);
+    }
+};
+
 class $modify(TypeInUI, EditorUI) {
     struct Fields {
         OnUIHide onUIHide;
@@ -107,18 +120,7 @@ class $modify(TypeInUI, EditorUI) {
     }
 
     void onNextFreeLayer(CCObject*) {
-        std::set<short> usedLayers;
-        for (auto obj : CCArrayExt<GameObject*>(m_editorLayer->m_objects)) {
-            usedLayers.insert(obj->m_editorLayer);
-            usedLayers.insert(obj->m_editorLayer2);
-        }
-
-        short nextFree  ;
-        for (nextFree = 0; nextFree < std::numeric_limits<short>::max(); nextFree += 1) {
-            if (!usedLayers.contains(nextFree)) {
-                break;
-            }
-        }
+        const auto nextFree = static_cast<short>(be::collectUsedIDs<EditorLayerSource>(m_editorLayer).findNextFree(0));
         m_editorLayer->m_currentLayer = nextFree;
         m_currentLayerLabel->setString(fmt::format("{}", nextFree).c_str());
 
@@ -2,6 +2,8 @@
 #include <Geode/binding/LevelEditorLayer.hpp>
 #include <Geode/ui/Notification.hpp>
 #include "Backup.hpp"
+#include "BackupWorker.hpp"
+#include "Retention.hpp"
 #include "QuickSave.hpp"
 
 using namespace geode::prelude;
@@ -70,29 +72,58 @@ class $modify(AutoSaveUI, EditorUI) {
                     // Save level
                     createAutoSave(m_editorLayer);
 
-                    // Create backup
-                    auto res = Backup::create(m_editorLayer->m_level, true);
-                    
-                    // Cleanup
-                    auto clean = Backup::cleanAutomated(m_editorLayer->m_level);
-                    if (!clean) {
-                        log::error("Failed to clean up automated backups: {}", clean.unwrapErr());
-                    }
+                    // Only copying the level happens here, writing the backup 
+                    // and cleaning up old ones is done on the backup worker
+                    Ref<Notification> notification = m_fields->autoSaveCountdownNotification;
+                    m_fields->autoSaveCountdownNotification = nullptr;
+                    notification->setTime(0);
+
+                    auto showResult = [notification](Result<> res) {
+                        // Show error / finished
+                        if (!res) {
+                            log::error("Backing level up failed: {}", res.unwrapErr());
+                            notification->setString("Backing up failed!");
+                            notification->setIcon(NotificationIcon::Error);
+                        }
+                        else {
+                            notification->setString("Level saved & backed up!");
+                            notification->setIcon(NotificationIcon::Success);
+                        }
 
-                    // Show error / finished
+                        // Hide the notification
+                        notification->hide();
+                    };
+
+                    // Create backup
+                    auto res = Backup::create(
+                        m_editorLayer->m_level, true,
+                        [notification](float progress) {
+                            notification->setString(fmt::format("Backing up... {}%", static_cast<int>(progress * 100)));
+                        },
+                        showResult
+                    );
                     if (!res) {
-                        log::error("Backing level up failed: {}", res.unwrapErr());
-                        m_fields->autoSaveCountdownNotification->setString("Backing up failed!");
-                        m_fields->autoSaveCountdownNotification->setIcon(NotificationIcon::Error);
+                        return showResult(Err(res.unwrapErr()));
                     }
-                    else {
-                        m_fields->autoSaveCountdownNotification->setString("Level saved & backed up!");
-                        m_fields->autoSaveCountdownNotification->setIcon(NotificationIcon::Success);
+                    if (!res.unwrap()) {
+                        notification->setString("No changes since the last backup");
+                        notification->setIcon(NotificationIcon::Info);
+                        notification->hide();
+                        return;
                     }
 
-                    // Hide the notification
-                    m_fields->autoSaveCountdownNotification->hide();
-                    m_fields->autoSaveCountdownNotification = nullptr;
+                    // Cleanup
+                    BackupWorker::get()->submit(
+                        [backupsDir = getBackupsDir(m_editorLayer->m_level), policy = RetentionPolicy::fromSettings()](auto const&) {
+                            return Backup::cleanAutomated(backupsDir, policy);
+                        },
+                        nullptr,
+                        [](Result<> clean) {
+                            if (!clean) {
+                                log::error("Failed to clean up automated backups: {}", clean.unwrapErr());
+                            }
+                        }
+                    );
                 });
             }
             // Warning countdown
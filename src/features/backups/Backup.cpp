@@ -1,108 +1,417 @@
 #include "Backup.hpp"
+#include "ChunkStore.hpp"
+#include "BackupWorker.hpp"
+#include "Retention.hpp"
+#include "BackupCatalog.hpp"
 #include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Mod.hpp>
 #include <Geode/utils/file.hpp>
 #include <Geode/utils/JsonValidation.hpp>
+#include <Geode/cocos/support/zip_support/ZipUtils.h>
 #include <hjfod.gmd-api/include/GMD.hpp>
 #include <cvolton.level-id-api/include/EditorIDs.hpp>
 #include <matjson/stl_serialize.hpp>
 #include <fmt/chrono.h>
+#include <utils/Hash.hpp>
+#include <mutex>
+#include <set>
 
-// todo: list backups associated with deleted / lost levels
-
+std::filesystem::path getBackupsRootDir() {
+    return dirs::getSaveDir() / "betteredit-level-backups";
+}
 std::filesystem::path getBackupsDir(GJGameLevel* level) {
-    return dirs::getSaveDir() / "betteredit-level-backups" / std::to_string(EditorIDs::getID(level));
+    return getBackupsRootDir() / std::to_string(EditorIDs::getID(level));
+}
+Result<> exportLevelSettings(GJGameLevel* level, std::filesystem::path const& path) {
+    gd::string levelString = level->m_levelString;
+    level->m_levelString = "";
+    auto res = gmd::exportLevelAsGmd(level, path);
+    level->m_levelString = levelString;
+    GEODE_UNWRAP(res.mapErr([](auto error) {
+        return fmt::format("Unable to save level: {}", error);
+    }));
+    return Ok();
 }
 
-struct BackupMetadata final {
-	typename Backup::TimePoint createTime = Backup::Clock::now();
-    bool automated = false;
-};
+matjson::Value matjson::Serialize<BackupMetadata>::toJson(BackupMetadata const& meta) {
+    return matjson::makeObject({
+        { "create-time", std::chrono::duration_cast<Backup::TimeUnit>(meta.createTime.time_since_epoch()).count() },
+        { "automated", meta.automated },
+        { "name", meta.name },
+        { "object-count", meta.objectCount },
+        { "byte-size", meta.byteSize },
+        { "hash", meta.hash },
+    });
+}
+Result<BackupMetadata> matjson::Serialize<BackupMetadata>::fromJson(matjson::Value const& value) {
+    auto meta = BackupMetadata();
+    auto obj = checkJson(value, "BackupMetadata");
+    int createTime;
+    obj.needs("create-time").into(createTime);
+    meta.createTime = Backup::TimePoint(Backup::TimeUnit(createTime));
+    obj.has("automated").into(meta.automated);
+    obj.has("name").into(meta.name);
+    obj.has("object-count").into(meta.objectCount);
+    obj.has("byte-size").into(meta.byteSize);
+    obj.has("hash").into(meta.hash);
+    return obj.ok(meta);
+}
 
 template <>
-struct matjson::Serialize<BackupMetadata> {
-    static matjson::Value toJson(BackupMetadata const& meta) {
-		return matjson::makeObject({
-			{ "create-time", std::chrono::duration_cast<Backup::TimeUnit>(meta.createTime.time_since_epoch()).count() },
-            { "automated", meta.automated },
-		});
-	}
-    static Result<BackupMetadata> fromJson(matjson::Value const& value) {
-		auto meta = BackupMetadata();
-		auto obj = checkJson(value, "BackupMetadata");
-        int createTime;
-        obj.needs("create-time").into(createTime);
-        meta.createTime = Backup::TimePoint(Backup::TimeUnit(createTime));
-        obj.has("automated").into(meta.automated);
-		return obj.ok(meta);
-	}
+struct matjson::Serialize<ChunkManifest> {
+    static matjson::Value toJson(ChunkManifest const& manifest) {
+        return matjson::makeObject({
+            { "chunks", manifest.chunks },
+            { "compressed", manifest.compressed },
+            { "size", manifest.size },
+        });
+    }
+    static Result<ChunkManifest> fromJson(matjson::Value const& value) {
+        auto manifest = ChunkManifest();
+        auto obj = checkJson(value, "ChunkManifest");
+        obj.needs("chunks").into(manifest.chunks);
+        obj.has("compressed").into(manifest.compressed);
+        obj.has("size").into(manifest.size);
+        return obj.ok(manifest);
+    }
+};
+
+// Backups made before the chunk store have the whole level in level.gmd and 
+// no manifest
+static constexpr auto MANIFEST_FILE = "chunks.json";
+
+// Folders of backups that have been snapshotted but not written yet. Any 
+// other folder without metadata was left behind by a write that failed or 
+// never finished, for example because the game was closed
+static std::mutex PENDING_MUTEX;
+static std::set<std::filesystem::path> PENDING_FOLDERS;
+
+static bool isPending(std::filesystem::path const& dir) {
+    std::lock_guard lock(PENDING_MUTEX);
+    return PENDING_FOLDERS.contains(dir);
+}
+static void setPending(std::filesystem::path const& dir, bool pending) {
+    std::lock_guard lock(PENDING_MUTEX);
+    if (pending) {
+        PENDING_FOLDERS.insert(dir);
+    }
+    else {
+        PENDING_FOLDERS.erase(dir);
+    }
+}
+
+// The level file is only parsed on the main thread, so this just looks for a 
+// non-empty level string in the raw file
+static bool hasLevelString(std::filesystem::path const& path) {
+    constexpr std::string_view KEY = "<k>k4</k><s>";
+    auto data = file::readString(path).unwrapOrDefault();
+    auto start = data.find(KEY);
+    return start != std::string::npos && data.size() > start + KEY.size() && data[start + KEY.size()] != '<';
+}
+// Backups are written in two steps: the folder and the settings are saved on 
+// the main thread, and the chunks, manifest and metadata on the worker. A 
+// backup with a manifest is only complete once its metadata is there too, and 
+// a legacy backup without one needs the whole level in its level file
+static bool isIncompleteBackup(std::filesystem::path const& dir) {
+    auto meta = file::readFromJson<BackupMetadata>(dir / "meta.json");
+    if (std::filesystem::exists(dir / MANIFEST_FILE)) {
+        return !meta;
+    }
+    // Legacy backups that already went through migration know their object 
+    // count, so their (possibly large) level file doesn't have to be read
+    if (meta && meta.unwrap().objectCount > 0) {
+        return false;
+    }
+    return !hasLevelString(dir / "level.gmd");
+}
+
+static size_t getFileSize(std::filesystem::path const& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<size_t>(size);
+}
+static Result<> collectUnusedChunks(std::filesystem::path const& backupsDir) {
+    std::vector<ChunkManifest> manifests;
+    for (auto folder : file::readDirectory(backupsDir).unwrapOrDefault()) {
+        if (!std::filesystem::exists(folder / MANIFEST_FILE)) {
+            continue;
+        }
+        // Better to leave some garbage around than to delete chunks that are 
+        // still in use because a manifest couldn't be read
+        GEODE_UNWRAP_INTO(auto manifest, file::readFromJson<ChunkManifest>(folder / MANIFEST_FILE).mapErr([&](auto error) {
+            return fmt::format("Unable to read manifest of backup at {}: {}", folder, error);
+        }));
+        manifests.push_back(std::move(manifest));
+    }
+    return ChunkStore(backupsDir).collectGarbage(manifests);
+}
+
+// Backup directories in a level's backup directory, newest first
+static std::vector<std::filesystem::path> getBackupFolders(std::filesystem::path const& backupsDir) {
+    std::vector<std::filesystem::path> folders;
+    for (auto folder : file::readDirectory(backupsDir).unwrapOrDefault()) {
+        if (std::filesystem::is_directory(folder) && folder.filename() != ChunkStore::DIRECTORY_NAME) {
+            folders.push_back(folder);
+        }
+    }
+    // Directories are named by their date, so this puts the newest ones first
+    std::sort(folders.begin(), folders.end(), std::greater<>());
+    return folders;
+}
+static std::optional<std::string> getLatestHash(std::filesystem::path const& backupsDir) {
+    for (auto folder : getBackupFolders(backupsDir)) {
+        auto meta = file::readFromJson<BackupMetadata>(folder / "meta.json");
+        if (meta && !meta.unwrap().hash.empty()) {
+            return meta.unwrap().hash;
+        }
+    }
+    return std::nullopt;
+}
+
+struct BackupFolder final {
+    std::filesystem::path directory;
+    BackupMetadata meta;
 };
+// Backups with their metadata, newest first. Backups whose metadata can't 
+// be read are left out, so they're never touched by cleanup
+static std::vector<BackupFolder> readBackupFolders(std::filesystem::path const& backupsDir) {
+    std::vector<BackupFolder> backups;
+    for (auto folder : getBackupFolders(backupsDir)) {
+        if (auto meta = file::readFromJson<BackupMetadata>(folder / "meta.json")) {
+            backups.push_back(BackupFolder {
+                .directory = folder,
+                .meta = meta.unwrap(),
+            });
+        }
+    }
+    return backups;
+}
+static Result<> removeBackupFolder(std::filesystem::path const& dir) {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    if (ec) {
+        return Err("Unable to delete backup directory: {} (code {})", ec.message(), ec.value());
+    }
+    BackupCatalog::recordRemoved(dir);
+    return Ok();
+}
+static uintmax_t getDirectorySize(std::filesystem::path const& dir) {
+    uintmax_t size = 0;
+    std::error_code ec;
+    auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+    for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code sizeError;
+        auto fileSize = it->is_regular_file(sizeError) ? it->file_size(sizeError) : 0;
+        size += sizeError ? 0 : fileSize;
+    }
+    return size;
+}
+// Delete the oldest automated backups of any level until all backups fit in 
+// the quota, always keeping the newest automated backup of each level
+static Result<> enforceTotalQuota(std::filesystem::path const& rootDir, uintmax_t quota) {
+    auto size = getDirectorySize(rootDir);
+    if (size <= quota) {
+        return Ok();
+    }
+
+    struct Candidate final {
+        std::filesystem::path backupsDir;
+        std::filesystem::path directory;
+        BackupMetadata::TimePoint createTime;
+    };
+    std::vector<Candidate> candidates;
+    for (auto backupsDir : file::readDirectory(rootDir).unwrapOrDefault()) {
+        if (!std::filesystem::is_directory(backupsDir)) {
+            continue;
+        }
+        bool isNewest = true;
+        for (auto const& backup : readBackupFolders(backupsDir)) {
+            if (!backup.meta.automated) {
+                continue;
+            }
+            if (!std::exchange(isNewest, false)) {
+                candidates.push_back(Candidate {
+                    .backupsDir = backupsDir,
+                    .directory = backup.directory,
+                    .createTime = backup.meta.createTime,
+                });
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](auto const& a, auto const& b) {
+        return a.createTime < b.createTime;
+    });
+
+    for (auto const& candidate : candidates) {
+        if (size <= quota) {
+            break;
+        }
+        const auto before = getDirectorySize(candidate.backupsDir);
+        GEODE_UNWRAP(removeBackupFolder(candidate.directory));
+        GEODE_UNWRAP(collectUnusedChunks(candidate.backupsDir));
+        const auto after = getDirectorySize(candidate.backupsDir);
+        size -= std::min(size, before - std::min(before, after));
+    }
+    return Ok();
+}
+
+static std::string hashLevelString(gd::string const& levelString) {
+    return be::hashToString(be::hash64(std::string_view(levelString.c_str(), levelString.size())));
+}
+static BackupMetadata createMetadata(GJGameLevel* level, size_t byteSize) {
+    return BackupMetadata {
+        .name = level->m_levelName,
+        .objectCount = static_cast<size_t>(level->m_objectCount),
+        .byteSize = byteSize,
+        .hash = hashLevelString(level->m_levelString),
+    };
+}
 
-GJGameLevel* Backup::getLevel() const {
-    return m_level;
+Result<GJGameLevel*> Backup::loadLevel() {
+    if (!m_level) {
+        GEODE_UNWRAP_INTO(Ref<GJGameLevel> level, gmd::importGmdAsLevel(m_directory / "level.gmd").mapErr([](auto error) {
+            return fmt::format("Unable to read level file: {}", error);
+        }));
+        if (std::filesystem::exists(m_directory / MANIFEST_FILE)) {
+            GEODE_UNWRAP_INTO(auto manifest, file::readFromJson<ChunkManifest>(m_directory / MANIFEST_FILE).mapErr([](auto error) {
+                return fmt::format("Unable to read manifest: {}", error);
+            }));
+            GEODE_UNWRAP_INTO(level->m_levelString, ChunkStore(m_directory.parent_path()).read(manifest));
+        }
+        m_level = level;
+    }
+    return Ok(m_level.data());
 }
 GJGameLevel* Backup::getOriginalLevel() const {
     return m_forLevel;
 }
+std::string Backup::getName() const {
+    return m_meta.name;
+}
 typename Backup::TimePoint Backup::getCreateTime() const {
-    return m_createTime;
+    return m_meta.createTime;
+}
+size_t Backup::getObjectCount() const {
+    return m_meta.objectCount;
+}
+size_t Backup::getByteSize() const {
+    return m_meta.byteSize;
+}
+std::string Backup::getHash() const {
+    return m_meta.hash;
 }
 bool Backup::isAutomated() const {
-    return m_automated;
+    return m_meta.automated;
 }
 
 Result<> Backup::restoreThis() {
+    GEODE_UNWRAP_INTO(auto level, this->loadLevel());
+
     // Add changes to memory
     // They should be saved on game close
-    m_forLevel->m_levelString = m_level->m_levelString;
-    m_forLevel->m_levelName = m_level->m_levelName;
-    m_forLevel->m_levelDesc = m_level->m_levelDesc;
-    m_forLevel->m_levelLength = m_level->m_levelLength;
-    m_forLevel->m_objectCount = m_level->m_objectCount;
-    m_forLevel->m_audioTrack = m_level->m_audioTrack;
-    m_forLevel->m_songID = m_level->m_songID;
-    m_forLevel->m_songIDs = m_level->m_songIDs;
-    m_forLevel->m_sfxIDs = m_level->m_sfxIDs;
-    m_forLevel->m_twoPlayerMode = m_level->m_twoPlayerMode;
+    m_forLevel->m_levelString = level->m_levelString;
+    m_forLevel->m_levelName = level->m_levelName;
+    m_forLevel->m_levelDesc = level->m_levelDesc;
+    m_forLevel->m_levelLength = level->m_levelLength;
+    m_forLevel->m_objectCount = level->m_objectCount;
+    m_forLevel->m_audioTrack = level->m_audioTrack;
+    m_forLevel->m_songID = level->m_songID;
+    m_forLevel->m_songIDs = level->m_songIDs;
+    m_forLevel->m_sfxIDs = level->m_sfxIDs;
+    m_forLevel->m_twoPlayerMode = level->m_twoPlayerMode;
     return Ok();
 }
-Result<> Backup::deleteThis() {
-    std::error_code ec;
-    std::filesystem::remove_all(m_directory, ec);
-    if (ec) {
-        return Err("Unable to delete backup directory: {} (code {})", ec.message(), ec.value());
-    }
-    return Ok();
+Result<be::LevelMerge> Backup::mergeWith(GJGameLevel* other) {
+    GEODE_UNWRAP_INTO(auto base, this->loadLevel());
+    return be::LevelMerge::computeForLevels(
+        base->m_levelString, m_forLevel->m_levelString, other->m_levelString
+    );
 }
-Result<> Backup::preserveAutomated() {
-    m_automated = false;
-    auto metadata = BackupMetadata {
-        .createTime = m_createTime,
-        .automated = false,
-    };
-    GEODE_UNWRAP(file::writeToJson(m_directory / "meta.json", metadata).mapErr([](auto error) {
-        return fmt::format("Unable to save metadata: {}", error);
+Result<> Backup::applyMerge(be::LevelMerge const& merge) {
+    // The level string is copied when the backup is created, so the level 
+    // can be changed right away even though the backup is written later
+    GEODE_UNWRAP(Backup::create(m_forLevel, false, nullptr, [](Result<> res) {
+        if (!res) {
+            log::error("Unable to back up level before merging: {}", res.unwrapErr());
+        }
+    }).mapErr([](auto error) {
+        return fmt::format("Unable to back up level before merging: {}", error);
     }));
+
+    // Add changes to memory
+    // They should be saved on game close
+    m_forLevel->m_levelString = ZipUtils::compressString(merge.levelString, false, 0);
+    m_forLevel->m_objectCount = merge.objectIDs.size();
     return Ok();
 }
+void Backup::deleteThis(std::function<void(Result<>)> onFinished) {
+    // The worker may be in the middle of writing chunks for a new backup or 
+    // cleaning up old ones, so the folder has to be removed there too
+    BackupWorker::get()->submit([dir = m_directory](auto const&) -> Result<> {
+        GEODE_UNWRAP(removeBackupFolder(dir));
+        if (auto res = collectUnusedChunks(dir.parent_path()); !res) {
+            log::warn("Unable to clean up unused chunks: {}", res.unwrapErr());
+        }
+        return Ok();
+    }, nullptr, std::move(onFinished));
+}
+void Backup::preserveAutomated(std::function<void(Result<>)> onFinished) {
+    auto meta = m_meta;
+    meta.automated = false;
+    // Written on the worker so cleaning up automated backups can't delete 
+    // this one while its metadata is being changed
+    BackupWorker::get()->submit([dir = m_directory, meta = std::move(meta)](auto const&) -> Result<> {
+        if (!std::filesystem::exists(dir / "meta.json")) {
+            return Err("The backup has already been deleted");
+        }
+        GEODE_UNWRAP(file::writeToJson(dir / "meta.json", meta).mapErr([](auto error) {
+            return fmt::format("Unable to save metadata: {}", error);
+        }));
+        BackupCatalog::recordAdded(dir, meta);
+        return Ok();
+    }, nullptr, std::move(onFinished));
+}
 
 Result<std::shared_ptr<Backup>> Backup::load(std::filesystem::path const& dir, GJGameLevel* forLevel) {
-    GEODE_UNWRAP_INTO(auto level, gmd::importGmdAsLevel(dir / "level.gmd").mapErr([](auto error) {
-        return fmt::format("Unable to read level file: {}", error);
-    }));
-    auto meta = file::readFromJson<BackupMetadata>(dir / "meta.json").unwrapOrDefault();
-
     auto backup = std::make_shared<Backup>();
-    backup->m_level = level;
     backup->m_forLevel = forLevel;
     backup->m_directory = dir;
-    backup->m_createTime = meta.createTime;
-    backup->m_automated = meta.automated;
+    backup->m_meta = file::readFromJson<BackupMetadata>(dir / "meta.json").unwrapOrDefault();
+
+    // Migrating a backup that hasn't been fully written would record an empty 
+    // level that wipes the real one when restored
+    if (isIncompleteBackup(dir)) {
+        return Err("Backup has not been fully written");
+    }
+
+    // Backups made before the metadata had everything needed for listing 
+    // them have to be parsed once, after which the metadata is updated so 
+    // this never has to be done again
+    if (backup->m_meta.hash.empty()) {
+        GEODE_UNWRAP_INTO(auto level, backup->loadLevel());
+        if (level->m_levelString.empty()) {
+            return Err("Backup has no level data");
+        }
+        auto meta = createMetadata(level, getFileSize(dir / "level.gmd"));
+        meta.createTime = backup->m_meta.createTime;
+        meta.automated = backup->m_meta.automated;
+        backup->m_meta = meta;
+        if (auto res = file::writeToJson(dir / "meta.json", meta); !res) {
+            log::warn("Unable to update metadata for backup at {}: {}", dir, res.unwrapErr());
+        }
+        BackupCatalog::recordAdded(dir, meta);
+        // Don't keep the level around since it was only needed for the metadata
+        backup->m_level = nullptr;
+    }
+
     return Ok(backup);
 }
 std::vector<std::shared_ptr<Backup>> Backup::load(GJGameLevel* level) {
     std::vector<std::shared_ptr<Backup>> res;
-    for (auto folder : file::readDirectory(getBackupsDir(level)).unwrapOrDefault()) {
-        if (!std::filesystem::is_directory(folder)) {
+    for (auto folder : getBackupFolders(getBackupsDir(level))) {
+        // Backups that are still being written (or never will be) are left 
+        // out like they are from cleanup; the worker deletes the latter
+        if (isIncompleteBackup(folder)) {
             continue;
         }
         auto b = Backup::load(folder, level);
@@ -112,20 +421,21 @@ std::vector<std::shared_ptr<Backup>> Backup::load(GJGameLevel* level) {
         }
         res.push_back(*b);
     }
-
-    // This takes advantage of the fact that directories are sorted 
-    // alphabetically and the date format is oldest-newest when sorted that way 
-    // Might want to consider a proper sort-by-newest-first
-    std::reverse(res.begin(), res.end());
-
     return res;
 }
-Result<> Backup::create(GJGameLevel* level, bool automated) {
+Result<std::optional<BackupSnapshot>> Backup::snapshot(GJGameLevel* level, bool automated) {
     if (level->m_levelType != GJLevelType::Editor) {
         return Err("Can not backup a non-editor level");
     }
     auto time = Clock::now();
 
+    // Autosaves keep happening while the editor is left idle, and there's no 
+    // point in filling the backups with identical copies of the level
+    auto hash = hashLevelString(level->m_levelString);
+    if (automated && getLatestHash(getBackupsDir(level)) == hash) {
+        return Ok(std::nullopt);
+    }
+
     auto dir = getBackupsDir(level) / fmt::format("{:%Y-%m-%d_%H-%M}", time);
     if (std::filesystem::exists(dir)) {
         return Err("Level was already backed up less than a minute ago");
@@ -134,54 +444,130 @@ Result<> Backup::create(GJGameLevel* level, bool automated) {
     GEODE_UNWRAP(file::createDirectoryAll(dir).mapErr([](auto error) {
         return fmt::format("Failed to create directory: {}", error);
     }));
+    setPending(dir, true);
 
-    GEODE_UNWRAP(gmd::exportLevelAsGmd(level, dir / "level.gmd").mapErr([](auto error) {
+    // The level file only holds the level's settings, since the objects are 
+    // written into the chunks later. Without the level string it's small 
+    // enough to not be worth moving off the main thread
+    if (auto res = exportLevelSettings(level, dir / "level.gmd"); !res) {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+        setPending(dir, false);
+        return Err(res.unwrapErr());
+    }
+
+    auto snapshot = BackupSnapshot {
+        .directory = dir,
+        .levelString = level->m_levelString,
+        .meta = BackupMetadata {
+            .createTime = time,
+            .automated = automated,
+            .name = level->m_levelName,
+            .objectCount = static_cast<size_t>(level->m_objectCount),
+            .hash = hash,
+        },
+        .compressionLevel = static_cast<int>(Mod::get()->template getSettingValue<int64_t>("backup-compression-level")),
+    };
+    return Ok(std::move(snapshot));
+}
+static Result<> writeSnapshot(BackupSnapshot const& snapshot, std::function<void(float)> const& progress) {
+    // Only the chunks that changed since the last backup get written
+    size_t writtenSize = 0;
+    GEODE_UNWRAP_INTO(auto manifest, ChunkStore(snapshot.directory.parent_path()).write(
+        snapshot.levelString, snapshot.compressionLevel, writtenSize, progress
+    ).mapErr([](auto error) {
         return fmt::format("Unable to save level: {}", error);
     }));
+    GEODE_UNWRAP(file::writeToJson(snapshot.directory / MANIFEST_FILE, manifest).mapErr([](auto error) {
+        return fmt::format("Unable to save manifest: {}", error);
+    }));
 
-    auto metadata = BackupMetadata {
-        .createTime = time,
-        .automated = automated,
-    };
-    GEODE_UNWRAP(file::writeToJson(dir / "meta.json", metadata).mapErr([](auto error) {
+    // The metadata is written last, since a backup with a manifest but no 
+    // metadata is treated as unfinished
+    auto metadata = snapshot.meta;
+    metadata.byteSize = writtenSize + getFileSize(snapshot.directory / "level.gmd");
+    GEODE_UNWRAP(file::writeToJson(snapshot.directory / "meta.json", metadata).mapErr([](auto error) {
         return fmt::format("Unable to save metadata: {}", error);
     }));
+    BackupCatalog::recordAdded(snapshot.directory, metadata);
 
     return Ok();
 }
-Result<> Backup::cleanAutomated(GJGameLevel* level) {
-    std::vector<std::shared_ptr<Backup>> automated;
-    for (auto folder : file::readDirectory(getBackupsDir(level)).unwrapOrDefault()) {
-        if (!std::filesystem::is_directory(folder)) {
-            continue;
-        }
-        auto b = Backup::load(folder, level);
-        if (!b) {
-            continue;
-        }
-        auto backup = *b;
-        if (backup->m_automated) {
-            automated.push_back(backup);
+Result<> Backup::write(BackupSnapshot const& snapshot, std::function<void(float)> const& progress) {
+    auto res = writeSnapshot(snapshot, progress);
+    if (!res) {
+        // Chunks that were already written are collected with the next 
+        // cleanup, once no manifest refers to them
+        std::error_code ec;
+        std::filesystem::remove_all(snapshot.directory, ec);
+    }
+    setPending(snapshot.directory, false);
+    return res;
+}
+Result<bool> Backup::create(
+    GJGameLevel* level, bool automated,
+    std::function<void(float)> onProgress,
+    std::function<void(Result<>)> onFinished
+) {
+    GEODE_UNWRAP_INTO(auto snapshot, Backup::snapshot(level, automated));
+    if (!snapshot) {
+        return Ok(false);
+    }
+    BackupWorker::get()->submit(
+        [snapshot = std::move(*snapshot)](auto const& progress) {
+            return Backup::write(snapshot, progress);
+        },
+        std::move(onProgress), std::move(onFinished)
+    );
+    return Ok(true);
+}
+Result<> Backup::cleanAutomated(std::filesystem::path const& backupsDir, RetentionPolicy const& policy) {
+    // Writes run on the worker too, so any folder that is incomplete and not 
+    // waiting to be written was left behind by one that never finished
+    bool deletedAny = false;
+    for (auto folder : getBackupFolders(backupsDir)) {
+        if (!isPending(folder) && isIncompleteBackup(folder)) {
+            GEODE_UNWRAP(removeBackupFolder(folder));
+            deletedAny = true;
         }
     }
 
-    // This takes advantage of the fact that directories are sorted 
-    // alphabetically and the date format is oldest-newest when sorted that way 
-    // Might want to consider a proper sort-by-newest-first
-    std::reverse(automated.begin(), automated.end());
+    // This runs on the worker, so it only reads the metadata files directly 
+    // instead of loading full Backups
+    auto backups = readBackupFolders(backupsDir);
+    std::vector<BackupMetadata> metadata;
+    for (auto const& backup : backups) {
+        metadata.push_back(backup.meta);
+    }
+    auto kept = policy.selectKept(metadata, Clock::now());
 
-    constexpr size_t MAX_AUTOMATED_COUNT = 3;
+    // Automated backups that are kept, newest first
+    std::vector<std::filesystem::path> automated;
+    for (size_t i = 0; i < backups.size(); i += 1) {
+        if (!kept[i]) {
+            GEODE_UNWRAP(removeBackupFolder(backups[i].directory));
+            deletedAny = true;
+        }
+        else if (backups[i].meta.automated) {
+            automated.push_back(backups[i].directory);
+        }
+    }
+    if (deletedAny) {
+        GEODE_UNWRAP(collectUnusedChunks(backupsDir));
+    }
 
-    // Do the cleanup if needed
-    if (automated.size() > MAX_AUTOMATED_COUNT) {
-        size_t ix = 0;
-        for (auto backup : automated) {
-            // Keep only the MAX_AUTOMATED_COUNT newest automated backups
-            if (++ix > MAX_AUTOMATED_COUNT) {
-                GEODE_UNWRAP(backup->deleteThis());
-            }
+    // Backups share chunks, so the only way to know how much space deleting 
+    // one frees up is to delete it and measure. The newest automated backup 
+    // is always kept
+    if (policy.levelQuota > 0) {
+        while (automated.size() > 1 && getDirectorySize(backupsDir) > policy.levelQuota) {
+            GEODE_UNWRAP(removeBackupFolder(automated.back()));
+            automated.pop_back();
+            GEODE_UNWRAP(collectUnusedChunks(backupsDir));
         }
-        automated.erase(automated.begin() + MAX_AUTOMATED_COUNT, automated.end());
+    }
+    if (policy.totalQuota > 0) {
+        GEODE_UNWRAP(enforceTotalQuota(backupsDir.parent_path(), policy.totalQuota));
     }
 
     return Ok();
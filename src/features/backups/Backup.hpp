@@ -2,37 +2,133 @@
 
 #include <Geode/binding/GJGameLevel.hpp>
 #include <Geode/utils/cocos.hpp>
+#include <matjson.hpp>
+#include <utils/LevelMerge.hpp>
 
 using namespace geode::prelude;
 
+struct RetentionPolicy;
+
+std::filesystem::path getBackupsRootDir();
 std::filesystem::path getBackupsDir(GJGameLevel* level);
+/**
+ * Export a level as a GMD file without its level string, for when the level 
+ * string is saved separately
+ */
+Result<> exportLevelSettings(GJGameLevel* level, std::filesystem::path const& path);
 
-class Backup final {
-public:
+struct BackupMetadata final {
     using Clock = std::chrono::system_clock;
     using TimePoint = std::chrono::time_point<Clock>;
+
+    TimePoint createTime = Clock::now();
+    bool automated = false;
+    std::string name;
+    size_t objectCount = 0;
+    // Size of the files this backup added on disk
+    size_t byteSize = 0;
+    // Hash of the level string
+    std::string hash;
+};
+
+template <>
+struct matjson::Serialize<BackupMetadata> {
+    static matjson::Value toJson(BackupMetadata const& meta);
+    static Result<BackupMetadata> fromJson(matjson::Value const& value);
+};
+
+/**
+ * Everything needed to write a backup, copied out of the level on the main 
+ * thread so the writing itself can be done on the backup worker
+ */
+struct BackupSnapshot final {
+    std::filesystem::path directory;
+    gd::string levelString;
+    BackupMetadata meta;
+    int compressionLevel;
+};
+
+class Backup final {
+public:
+    using Clock = BackupMetadata::Clock;
+    using TimePoint = BackupMetadata::TimePoint;
     using TimeUnit = std::chrono::minutes;
 
 private:
     std::filesystem::path m_directory;
+    // Only loaded when the backup is actually viewed or restored
     Ref<GJGameLevel> m_level;
     Ref<GJGameLevel> m_forLevel;
-    TimePoint m_createTime;
-    bool m_automated;
+    BackupMetadata m_meta;
 
 public:
     static Result<std::shared_ptr<Backup>> load(std::filesystem::path const& dir, GJGameLevel* forLevel);
     static std::vector<std::shared_ptr<Backup>> load(GJGameLevel* level);
-    static Result<> create(GJGameLevel* level, bool automated);
-    static Result<> cleanAutomated(GJGameLevel* level);
+    /**
+     * Copy the level into a snapshot. This creates the backup's directory and 
+     * saves the level's settings, but the level string is only written by 
+     * `write`. Automated backups are skipped (and `std::nullopt` returned) if 
+     * the level hasn't changed since the last backup
+     */
+    static Result<std::optional<BackupSnapshot>> snapshot(GJGameLevel* level, bool automated);
+    /**
+     * Write a snapshot to disk. Doesn't touch any game objects, so this can 
+     * be run on the backup worker. If writing fails, the snapshot's directory 
+     * is removed
+     */
+    static Result<> write(BackupSnapshot const& snapshot, std::function<void(float)> const& progress);
+    /**
+     * Snapshot the level and write it on the backup worker. Only errors from 
+     * taking the snapshot are returned, the rest go to `onFinished`. Returns 
+     * false if the backup was skipped, in which case the callbacks are never 
+     * called
+     */
+    static Result<bool> create(
+        GJGameLevel* level, bool automated,
+        std::function<void(float)> onProgress,
+        std::function<void(Result<>)> onFinished
+    );
+    /**
+     * Delete the automated backups in a level's backup directory that the 
+     * retention policy doesn't keep. Only reads the metadata, so this can be 
+     * run on the backup worker
+     */
+    static Result<> cleanAutomated(std::filesystem::path const& backupsDir, RetentionPolicy const& policy);
 
-    GJGameLevel* getLevel() const;
+    /**
+     * Load the backed up level. This parses the whole level file, so avoid 
+     * calling it unless the level itself is needed
+     */
+    Result<GJGameLevel*> loadLevel();
     GJGameLevel* getOriginalLevel() const;
+    std::string getName() const;
     TimePoint getCreateTime() const;
+    size_t getObjectCount() const;
+    size_t getByteSize() const;
+    std::string getHash() const;
     bool isAutomated() const;
 
     Result<> restoreThis();
-    Result<> deleteThis();
-    Result<> preserveAutomated();
+    /**
+     * Merge another copy of the level into the current level, using this 
+     * backup as their common ancestor. The current level is left untouched 
+     * until the merge is applied
+     */
+    Result<be::LevelMerge> mergeWith(GJGameLevel* other);
+    /**
+     * Replace the current level's objects and settings with a merge. The 
+     * current level is backed up first
+     */
+    Result<> applyMerge(be::LevelMerge const& merge);
+    /**
+     * Delete the backup on the backup worker. The backup list should only be 
+     * reloaded once `onFinished` is called
+     */
+    void deleteThis(std::function<void(Result<>)> onFinished);
+    /**
+     * Turn an automated backup into a normal one on the backup worker. This 
+     * object's metadata is left as is, reload the backup to see the change
+     */
+    void preserveAutomated(std::function<void(Result<>)> onFinished);
 };
 using BackupPtr = std::shared_ptr<Backup>;
@@ -0,0 +1,185 @@
+#include "BackupCatalog.hpp"
+#include "ChunkStore.hpp"
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/JsonValidation.hpp>
+#include <fstream>
+#include <mutex>
+#include <set>
+
+static constexpr auto CATALOG_FILE = "catalog.jsonl";
+// The first line of a catalog that lists every backup. Records can get 
+// appended before the catalog has been built, and such a file is missing 
+// all the backups made before it
+static constexpr std::string_view CATALOG_HEADER = R"({"catalog":1})";
+// Rewrite the catalog once most of its records are outdated
+static constexpr size_t COMPACT_THRESHOLD = 64;
+
+static std::mutex CATALOG_MUTEX;
+
+static std::filesystem::path getCatalogPath() {
+    return getBackupsRootDir() / CATALOG_FILE;
+}
+// Backups are identified by their level ID and folder name
+static std::string getBackupKey(std::filesystem::path const& backupDir) {
+    return backupDir.parent_path().filename().string() + "/" + backupDir.filename().string();
+}
+
+static void appendRecord(matjson::Value const& record) {
+    std::unique_lock lock(CATALOG_MUTEX);
+    (void)file::createDirectoryAll(getBackupsRootDir());
+    std::ofstream out(getCatalogPath(), std::ios::app | std::ios::binary);
+    out << record.dump(matjson::NO_INDENTATION) << '\n';
+    if (!out) {
+        log::warn("Unable to update backup catalog");
+    }
+}
+
+static std::map<std::string, BackupMetadata> scanBackupFolders() {
+    std::map<std::string, BackupMetadata> backups;
+    for (auto levelDir : file::readDirectory(getBackupsRootDir()).unwrapOrDefault()) {
+        if (!std::filesystem::is_directory(levelDir)) {
+            continue;
+        }
+        for (auto folder : file::readDirectory(levelDir).unwrapOrDefault()) {
+            if (!std::filesystem::is_directory(folder) || folder.filename() == ChunkStore::DIRECTORY_NAME) {
+                continue;
+            }
+            if (auto meta = file::readFromJson<BackupMetadata>(folder / "meta.json")) {
+                backups.emplace(getBackupKey(folder), meta.unwrap());
+            }
+        }
+    }
+    return backups;
+}
+static void writeCatalog(std::map<std::string, BackupMetadata> const& backups, std::set<std::string> const& restored) {
+    auto path = getCatalogPath();
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary);
+        out << CATALOG_HEADER << '\n';
+        for (auto const& [key, meta] : backups) {
+            out << matjson::makeObject({
+                { "op", "add" },
+                { "backup", key },
+                { "meta", meta },
+            }).dump(matjson::NO_INDENTATION) << '\n';
+            if (restored.contains(key)) {
+                out << matjson::makeObject({
+                    { "op", "restore" },
+                    { "backup", key },
+                }).dump(matjson::NO_INDENTATION) << '\n';
+            }
+        }
+        if (!out) {
+            log::warn("Unable to write backup catalog");
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        log::warn("Unable to write backup catalog: {} (code {})", ec.message(), ec.value());
+    }
+}
+
+void BackupCatalog::recordAdded(std::filesystem::path const& backupDir, BackupMetadata const& meta) {
+    appendRecord(matjson::makeObject({
+        { "op", "add" },
+        { "backup", getBackupKey(backupDir) },
+        { "meta", meta },
+    }));
+}
+void BackupCatalog::recordRemoved(std::filesystem::path const& backupDir) {
+    appendRecord(matjson::makeObject({
+        { "op", "remove" },
+        { "backup", getBackupKey(backupDir) },
+    }));
+}
+void BackupCatalog::recordRestored(std::filesystem::path const& backupDir) {
+    appendRecord(matjson::makeObject({
+        { "op", "restore" },
+        { "backup", getBackupKey(backupDir) },
+    }));
+}
+
+std::vector<BackupCatalog::CatalogLevel> BackupCatalog::load() {
+    std::unique_lock lock(CATALOG_MUTEX);
+
+    std::map<std::string, BackupMetadata> backups;
+    std::set<std::string> restored;
+    bool complete = false;
+    size_t recordCount = 0;
+    {
+        std::ifstream in(getCatalogPath(), std::ios::binary);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (recordCount++ == 0 && line == CATALOG_HEADER) {
+                complete = true;
+                continue;
+            }
+            // The last line may have been cut short if the game closed while 
+            // it was being written
+            auto record = matjson::parse(line);
+            if (!record) {
+                continue;
+            }
+            auto obj = checkJson(record.unwrap(), "CatalogRecord");
+            std::string op;
+            std::string key;
+            obj.needs("op").into(op);
+            obj.needs("backup").into(key);
+            if (!obj.ok()) {
+                continue;
+            }
+            if (op == "add") {
+                if (auto meta = record.unwrap()["meta"].as<BackupMetadata>()) {
+                    backups.insert_or_assign(key, meta.unwrap());
+                }
+            }
+            else if (op == "remove") {
+                backups.erase(key);
+                restored.erase(key);
+            }
+            else if (op == "restore") {
+                restored.insert(key);
+            }
+        }
+    }
+    if (!complete) {
+        backups = scanBackupFolders();
+        std::erase_if(restored, [&](auto const& key) { return !backups.contains(key); });
+        writeCatalog(backups, restored);
+    }
+    else if (recordCount > backups.size() * 2 + COMPACT_THRESHOLD) {
+        writeCatalog(backups, restored);
+    }
+
+    std::map<int, CatalogLevel> levels;
+    for (auto const& [key, meta] : backups) {
+        auto levelID = numFromString<int>(key.substr(0, key.find('/')));
+        if (!levelID) {
+            continue;
+        }
+        auto& level = levels[*levelID];
+        level.levelID = *levelID;
+        level.restored |= restored.contains(key);
+        level.backups.push_back(CatalogBackup {
+            .directory = getBackupsRootDir() / std::filesystem::path(key),
+            .meta = meta,
+        });
+    }
+
+    std::vector<CatalogLevel> res;
+    for (auto& [id, level] : levels) {
+        std::sort(level.backups.begin(), level.backups.end(), [](auto const& a, auto const& b) {
+            return a.meta.createTime > b.meta.createTime;
+        });
+        level.name = level.backups.front().meta.name;
+        res.push_back(std::move(level));
+    }
+    std::sort(res.begin(), res.end(), [](auto const& a, auto const& b) {
+        return a.backups.front().meta.createTime > b.backups.front().meta.createTime;
+    });
+    return res;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Backup.hpp"
+
+/**
+ * One append-only file listing the backups of every level, so all backups 
+ * can be found without having to know which levels they belong to or scan 
+ * through every backup folder. Each line records a backup being added, its 
+ * metadata changing, it being removed, or it being restored as a new 
+ * level. Everything here is thread-safe
+ */
+class BackupCatalog final {
+public:
+    struct CatalogBackup final {
+        std::filesystem::path directory;
+        BackupMetadata meta;
+    };
+    struct CatalogLevel final {
+        int levelID;
+        // The name of the level in its newest backup
+        std::string name;
+        // Newest first
+        std::vector<CatalogBackup> backups;
+        // Whether one of the backups has been restored as a new level
+        bool restored = false;
+    };
+
+    static void recordAdded(std::filesystem::path const& backupDir, BackupMetadata const& meta);
+    static void recordRemoved(std::filesystem::path const& backupDir);
+    static void recordRestored(std::filesystem::path const& backupDir);
+
+    /**
+     * Read every backup in the catalog, grouped by level with the most 
+     * recently backed up levels first. The first time this is called the 
+     * catalog is built by scanning all backup folders, so call this on the 
+     * backup worker
+     */
+    static std::vector<CatalogLevel> load();
+};
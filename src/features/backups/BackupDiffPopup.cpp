@@ -0,0 +1,119 @@
+#include "BackupDiffPopup.hpp"
+#include "BackupItem.hpp"
+#include <Geode/ui/General.hpp>
+#include <Geode/binding/ButtonSprite.hpp>
+#include <Geode/binding/EditorUI.hpp>
+#include <utils/Editor.hpp>
+#include <fmt/ranges.h>
+
+// How many level settings to list by name before just counting the rest
+static constexpr size_t MAX_LISTED_SETTINGS = 4;
+
+static Result<be::LevelDiff> diffWithCurrentLevel(BackupPtr backup) {
+    GEODE_UNWRAP_INTO(auto backupLevel, backup->loadLevel());
+    return be::LevelDiff::computeForLevels(
+        backupLevel->m_levelString, backup->getOriginalLevel()->m_levelString
+    );
+}
+
+bool BackupDiffPopup::setup(BackupPtr backup) {
+    m_backup = backup;
+
+    this->setTitle("Changes Since Backup");
+
+    auto column = CCNode::create();
+    column->setContentSize({ 260, 140 });
+    column->setLayout(
+        ColumnLayout::create()
+            ->setGap(4)
+            ->setAxisReverse(true)
+            ->setAxisAlignment(AxisAlignment::End)
+            ->setCrossAxisLineAlignment(AxisAlignment::Start)
+    );
+    m_mainLayer->addChildAtPosition(column, Anchor::Center, ccp(0, 5));
+
+    auto addLine = [column](std::string const& text, ccColor3B color) {
+        auto label = CCLabelBMFont::create(text.c_str(), "bigFont.fnt");
+        label->setColor(color);
+        label->limitLabelWidth(column->getContentWidth(), .45f, .1f);
+        column->addChild(label);
+    };
+
+    auto diff = diffWithCurrentLevel(backup);
+    if (!diff) {
+        addLine("Unable to compare backup:", { 255, 90, 90 });
+        addLine(diff.unwrapErr(), { 255, 255, 255 });
+        column->updateLayout();
+        this->addCorners(Corner::Brown, Corner::Gold);
+        return true;
+    }
+    m_diff = std::move(diff).unwrap();
+
+    if (m_diff.empty()) {
+        addLine("No changes since this backup", { 255, 255, 255 });
+    }
+    else {
+        addLine(fmt::format("{} objects added", m_diff.added.size()), { 90, 255, 90 });
+        addLine(fmt::format("{} objects removed", m_diff.removed.size()), { 255, 90, 90 });
+        addLine(fmt::format("{} objects modified", m_diff.modified.size()), { 255, 255, 90 });
+        addLine(fmt::format("{} objects unchanged", m_diff.unchanged.size()), { 200, 200, 200 });
+
+        auto const& settings = m_diff.changedSettings;
+        if (settings.empty()) {
+            addLine("Level settings unchanged", { 200, 200, 200 });
+        }
+        else {
+            auto listed = fmt::format("{}", fmt::join(
+                settings.begin(), settings.begin() + std::min(settings.size(), MAX_LISTED_SETTINGS), ", "
+            ));
+            if (settings.size() > MAX_LISTED_SETTINGS) {
+                listed += fmt::format(" and {} more", settings.size() - MAX_LISTED_SETTINGS);
+            }
+            addLine(fmt::format("Level settings changed: {}", listed), { 90, 200, 255 });
+        }
+    }
+    column->updateLayout();
+
+    // Added objects only exist in the current level, so there is nothing to 
+    // select for them in the backup
+    if (!m_diff.removed.empty() || !m_diff.modified.empty()) {
+        auto selectSpr = ButtonSprite::create("Select Changes", "goldFont.fnt", "GJ_button_01.png", .8f);
+        selectSpr->setScale(.7f);
+        auto selectBtn = CCMenuItemSpriteExtra::create(
+            selectSpr, this, menu_selector(BackupDiffPopup::onSelectChanges)
+        );
+        m_buttonMenu->addChildAtPosition(selectBtn, Anchor::Bottom, ccp(0, 25));
+    }
+
+    this->addCorners(Corner::Brown, Corner::Gold);
+
+    return true;
+}
+
+void BackupDiffPopup::onSelectChanges(CCObject*) {
+    auto editor = openBackupInViewOnlyEditor(m_backup);
+    if (!editor) {
+        return;
+    }
+
+    std::vector<int> objectIDs;
+    objectIDs.reserve(m_diff.fromObjects.size());
+    for (auto const& record : m_diff.fromObjects) {
+        objectIDs.push_back(record.objectID);
+    }
+    auto objs = be::findObjectsByStringIndex(editor, objectIDs, m_diff.getChangedFromIndices());
+    if (objs->count()) {
+        editor->m_editorUI->selectObjects(objs, true);
+        be::focusEditorOnObjects(editor->m_editorUI, objs, false);
+    }
+}
+
+BackupDiffPopup* BackupDiffPopup::create(BackupPtr backup) {
+    auto ret = new BackupDiffPopup();
+    if (ret && ret->initAnchored(320, 220, backup)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Geode/ui/Popup.hpp>
+#include "Backup.hpp"
+#include <utils/LevelDiff.hpp>
+#include <utils/PopupWithCorners.hpp>
+
+using namespace geode::prelude;
+
+/**
+ * Shows what has changed in a level since a backup of it was made
+ */
+class BackupDiffPopup : public PopupWithCorners<BackupPtr> {
+protected:
+    BackupPtr m_backup;
+    be::LevelDiff m_diff;
+
+    bool setup(BackupPtr backup) override;
+
+    void onSelectChanges(CCObject*);
+
+public:
+    static BackupDiffPopup* create(BackupPtr backup);
+};
@@ -1,9 +1,11 @@
 #include "BackupItem.hpp"
 #include "BackupListPopup.hpp"
+#include "BackupDiffPopup.hpp"
 #include <fmt/chrono.h>
 #include <utils/Editor.hpp>
 #include <Geode/ui/BasedButtonSprite.hpp>
 #include <Geode/binding/EditLevelLayer.hpp>
+#include <hjfod.gmd-api/include/GMD.hpp>
 
 bool BackupItem::init(BackupPtr backup) {
     if (!CCNode::init())
@@ -20,12 +22,15 @@ bool BackupItem::init(BackupPtr backup) {
     bg->setContentSize(m_obContentSize / bg->getScale());
     this->addChildAtPosition(bg, Anchor::Center);
 
-    auto title = CCLabelBMFont::create(backup->getLevel()->m_levelName.c_str(), "bigFont.fnt");
+    auto title = CCLabelBMFont::create(backup->getName().c_str(), "bigFont.fnt");
     title->setAnchorPoint({ 0, .5f });
     title->setScale(.5f);
     this->addChildAtPosition(title, Anchor::Left, ccp(5, 7));
 
-    auto time = CCLabelBMFont::create(fmt::format("{:%Y/%m/%d at %H:%M}", backup->getCreateTime()).c_str(), "goldFont.fnt");
+    auto time = CCLabelBMFont::create(fmt::format(
+        "{:%Y/%m/%d at %H:%M} | {} objects | {:.1f} MB",
+        backup->getCreateTime(), backup->getObjectCount(), backup->getByteSize() / 1'000'000.0
+    ).c_str(), "goldFont.fnt");
     time->setAnchorPoint({ 0, .5f });
     time->setScale(.4f);
     this->addChildAtPosition(time, Anchor::Left, ccp(5, -7));
@@ -54,6 +59,18 @@ bool BackupItem::init(BackupPtr backup) {
     );
     menu->addChild(viewBtn);
 
+    auto diffSpr = CCSprite::createWithSpriteFrameName("GJ_infoIcon_001.png");
+    auto diffBtn = CCMenuItemSpriteExtra::create(
+        diffSpr, this, menu_selector(BackupItem::onDiff)
+    );
+    menu->addChild(diffBtn);
+
+    auto mergeSpr = CCSprite::createWithSpriteFrameName("GJ_copyBtn_001.png");
+    auto mergeBtn = CCMenuItemSpriteExtra::create(
+        mergeSpr, this, menu_selector(BackupItem::onMerge)
+    );
+    menu->addChild(mergeBtn);
+
     if (backup->isAutomated()) {
         bg->setColor({ 30, 93, 156 });
 
@@ -79,35 +96,146 @@ void BackupItem::onConvertAutomated(CCObject*) {
     createQuickPopup(
         "Preserve Backup",
         "Do you want to <cj>preserve this automated backup</c>?\n"
-        "By default, <cy>automated backups are deleted after three newer backups have been made</c>.\n"
+        "By default, <cy>old automated backups are deleted according to the backup retention settings</c>.\n"
         "Preserving the backup turns it into a normal backup, <cp>preventing it from being deleted automatically</c>.",
         "Cancel", "Preserve",
         [this](auto*, bool btn2) {
             if (btn2) {
-                auto res = m_backup->preserveAutomated();
-                if (!res) {
-                    FLAlertLayer::create(
-                        "Unable to Preserve Backup",
-                        fmt::format("Unable to preserve backup: {}", res.unwrapErr()),
-                        "OK"
-                    )->show();
-                }
-                UpdateBackupListEvent().post();
+                m_backup->preserveAutomated([](Result<> res) {
+                    if (!res) {
+                        FLAlertLayer::create(
+                            "Unable to Preserve Backup",
+                            fmt::format("Unable to preserve backup: {}", res.unwrapErr()),
+                            "OK"
+                        )->show();
+                    }
+                    UpdateBackupListEvent().post();
+                });
             }
         }
     );
 }
-void BackupItem::onView(CCObject*) {
+LevelEditorLayer* openBackupInViewOnlyEditor(BackupPtr backup) {
+    auto backupLevel = backup->loadLevel();
+    if (!backupLevel) {
+        FLAlertLayer::create(
+            "Unable to View Backup",
+            fmt::format("Unable to load backup: {}", backupLevel.unwrapErr()),
+            "OK"
+        )->show();
+        return nullptr;
+    }
     auto scene = CCScene::create();
-    scene->addChild(be::createViewOnlyEditor(m_backup->getLevel(), [level = m_backup->getOriginalLevel()]() {
+    auto editor = be::createViewOnlyEditor(*backupLevel, [level = backup->getOriginalLevel()]() {
         auto layer = EditLevelLayer::create(level);
         auto popup = BackupListPopup::create(level);
         popup->m_scene = layer;
         popup->m_noElasticity = true;
         popup->show();
         return static_cast<CCLayer*>(layer);
-    }));
+    });
+    scene->addChild(editor);
     CCDirector::get()->replaceScene(CCTransitionFade::create(.5f, scene));
+    return editor;
+}
+
+void BackupItem::onView(CCObject*) {
+    openBackupInViewOnlyEditor(m_backup);
+}
+void BackupItem::onDiff(CCObject*) {
+    BackupDiffPopup::create(m_backup)->show();
+}
+void BackupItem::onMerge(CCObject*) {
+    createQuickPopup(
+        "Merge Level",
+        "Pick an <cy>exported copy of this level</c> to <cj>merge into the current level</c>.\n"
+        "This backup is used as the <cp>common ancestor</c> of both copies, so it "
+        "should be from before they were edited separately.",
+        "Cancel", "Pick File",
+        [this](auto*, bool btn2) {
+            if (!btn2) {
+                return;
+            }
+            m_pickListener.bind(this, &BackupItem::onMergeFilePicked);
+            m_pickListener.setFilter(file::pick(file::PickMode::OpenFile, file::FilePickOptions {
+                .filters = {
+                    file::FilePickOptions::Filter {
+                        .description = "GD Level Files",
+                        .files = { "*.gmd" },
+                    },
+                },
+            }));
+        }
+    );
+}
+void BackupItem::onMergeFilePicked(PickTask::Event* ev) {
+    auto showError = [](std::string const& error) {
+        FLAlertLayer::create(
+            "Unable to Merge",
+            fmt::format("Unable to merge level: {}", error),
+            "OK"
+        )->show();
+    };
+
+    // Still picking or cancelled
+    auto picked = ev->getValue();
+    if (!picked) {
+        return;
+    }
+    if (picked->isErr()) {
+        return showError(picked->unwrapErr());
+    }
+    auto other = gmd::importGmdAsLevel(picked->unwrap());
+    if (!other) {
+        return showError(other.unwrapErr());
+    }
+    auto res = m_backup->mergeWith(*other);
+    if (!res) {
+        return showError(res.unwrapErr());
+    }
+    auto merge = std::make_shared<be::LevelMerge>(std::move(res).unwrap());
+
+    auto summary = fmt::format(
+        "The merged level has <cy>{} changes</c> from the current level and "
+        "<cj>{} changes</c> from the picked level.",
+        merge->oursChanges, merge->theirsChanges
+    );
+    if (!merge->conflicts.empty()) {
+        summary += fmt::format(
+            "\n<cr>{} objects conflict</c>. Every version of them is kept, and "
+            "they will be selected in the editor.",
+            merge->conflicts.size()
+        );
+    }
+    if (!merge->conflictingSettings.empty()) {
+        summary += fmt::format(
+            "\n<co>{} level settings conflict</c>. The current level's values are kept.",
+            merge->conflictingSettings.size()
+        );
+    }
+    summary += "\nThe current level will be backed up first.";
+
+    createQuickPopup(
+        "Apply Merge", summary, "Cancel", "Apply",
+        [backup = m_backup, merge, showError](auto*, bool btn2) {
+            if (!btn2) {
+                return;
+            }
+            auto res = backup->applyMerge(*merge);
+            if (!res) {
+                return showError(res.unwrapErr());
+            }
+            auto level = backup->getOriginalLevel();
+            auto scene = LevelEditorLayer::scene(level, false);
+            auto editor = LevelEditorLayer::get();
+            auto conflicts = be::findObjectsByStringIndex(editor, merge->objectIDs, merge->conflicts);
+            if (conflicts->count()) {
+                editor->m_editorUI->selectObjects(conflicts, true);
+                be::focusEditorOnObjects(editor->m_editorUI, conflicts, false);
+            }
+            CCDirector::get()->replaceScene(CCTransitionFade::create(.5f, scene));
+        }
+    );
 }
 void BackupItem::onRestore(CCObject*) {
     createQuickPopup(
@@ -142,15 +270,16 @@ void BackupItem::onDelete(CCObject*) {
         "Cancel", "Delete",
         [this](auto*, bool btn2) {
             if (btn2) {
-                auto res = m_backup->deleteThis();
-                if (!res) {
-                    FLAlertLayer::create(
-                        "Unable to Delete Backup",
-                        fmt::format("Unable to delete backup: {}", res.unwrapErr()),
-                        "OK"
-                    )->show();
-                }
-                UpdateBackupListEvent().post();
+                m_backup->deleteThis([](Result<> res) {
+                    if (!res) {
+                        FLAlertLayer::create(
+                            "Unable to Delete Backup",
+                            fmt::format("Unable to delete backup: {}", res.unwrapErr()),
+                            "OK"
+                        )->show();
+                    }
+                    UpdateBackupListEvent().post();
+                });
             }
         }
     );
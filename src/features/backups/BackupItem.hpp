@@ -2,20 +2,34 @@
 
 #include <Geode/DefaultInclude.hpp>
 #include "Backup.hpp"
+#include <Geode/binding/LevelEditorLayer.hpp>
+#include <Geode/utils/file.hpp>
 
 using namespace geode::prelude;
 
+/**
+ * Open a backup in a view-only editor that returns to the backup list. Shows 
+ * an error and returns null if the backup couldn't be loaded
+ */
+LevelEditorLayer* openBackupInViewOnlyEditor(BackupPtr backup);
+
 struct UpdateBackupListEvent : public Event {
     bool closeList = false;
 };
 
 class BackupItem : public CCNode {
 protected:
+    using PickTask = Task<Result<std::filesystem::path>>;
+
     BackupPtr m_backup;
+    EventListener<PickTask> m_pickListener;
 
     bool init(BackupPtr backup);
 
     void onView(CCObject*);
+    void onDiff(CCObject*);
+    void onMerge(CCObject*);
+    void onMergeFilePicked(PickTask::Event* ev);
     void onRestore(CCObject*);
     void onDelete(CCObject*);
     void onConvertAutomated(CCObject*);
@@ -75,15 +75,24 @@ void BackupListPopup::updateList() {
 }
 
 void BackupListPopup::onNewBackup(CCObject*) {
-    auto res = Backup::create(m_level, false);
-    if (!res) {
+    auto showError = [](std::string const& error) {
         FLAlertLayer::create(
             "Unable to Backup",
-            fmt::format("Unable to create a backup: {}", res.unwrapErr()),
+            fmt::format("Unable to create a backup: {}", error),
             "OK"
         )->show();
+    };
+    // The backup is written in the background, and the list gets updated 
+    // once it's done
+    auto res = Backup::create(m_level, false, nullptr, [showError](Result<> res) {
+        if (!res) {
+            showError(res.unwrapErr());
+        }
+        UpdateBackupListEvent().post();
+    });
+    if (!res) {
+        showError(res.unwrapErr());
     }
-    this->updateList();
 }
 
 BackupListPopup* BackupListPopup::create(GJGameLevel* level) {
@@ -0,0 +1,56 @@
+#include "BackupWorker.hpp"
+#include <Geode/loader/Loader.hpp>
+
+BackupWorker::BackupWorker() {
+    // The worker lives for as long as the game does, so it's never joined
+    std::thread(&BackupWorker::run, this).detach();
+}
+
+void BackupWorker::run() {
+    while (true) {
+        std::pair<size_t, Job> job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return !m_queue.empty(); });
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        const auto id = job.first;
+        auto res = job.second([id](float progress) {
+            Loader::get()->queueInMainThread([id, progress] {
+                auto worker = BackupWorker::get();
+                if (auto it = worker->m_callbacks.find(id); it != worker->m_callbacks.end() && it->second.onProgress) {
+                    it->second.onProgress(progress);
+                }
+            });
+        });
+        Loader::get()->queueInMainThread([id, res = std::move(res)] {
+            auto worker = BackupWorker::get();
+            if (auto it = worker->m_callbacks.find(id); it != worker->m_callbacks.end()) {
+                auto onFinished = std::move(it->second.onFinished);
+                worker->m_callbacks.erase(it);
+                if (onFinished) {
+                    onFinished(res);
+                }
+            }
+        });
+    }
+}
+
+BackupWorker* BackupWorker::get() {
+    static auto inst = new BackupWorker();
+    return inst;
+}
+
+void BackupWorker::submit(Job&& job, ProgressCallback onProgress, FinishedCallback onFinished) {
+    const auto id = m_nextJobID++;
+    m_callbacks.emplace(id, Callbacks {
+        .onProgress = std::move(onProgress),
+        .onFinished = std::move(onFinished),
+    });
+    {
+        std::unique_lock lock(m_mutex);
+        m_queue.emplace_back(id, std::move(job));
+    }
+    m_condition.notify_one();
+}
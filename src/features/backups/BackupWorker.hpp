@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+using namespace geode::prelude;
+
+/**
+ * Writes backups and crash data on a background thread so the editor 
+ * doesn't freeze while they're saved. Jobs run one at a time in the order 
+ * they were submitted, so a job always sees everything earlier jobs wrote
+ */
+class BackupWorker final {
+public:
+    using ProgressCallback = std::function<void(float)>;
+    using FinishedCallback = std::function<void(Result<>)>;
+    /**
+     * Runs on the worker thread, so it must not capture or touch any game 
+     * objects
+     */
+    using Job = std::function<Result<>(ProgressCallback const& progress)>;
+
+protected:
+    struct Callbacks final {
+        ProgressCallback onProgress;
+        FinishedCallback onFinished;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::pair<size_t, Job>> m_queue;
+    // Only ever touched by the main thread
+    std::unordered_map<size_t, Callbacks> m_callbacks;
+    size_t m_nextJobID = 0;
+
+    BackupWorker();
+    void run();
+
+public:
+    static BackupWorker* get();
+
+    /**
+     * Queue a job on the worker. Must be called from the main thread, and the 
+     * callbacks are called on the main thread too
+     */
+    void submit(Job&& job, ProgressCallback onProgress = nullptr, FinishedCallback onFinished = nullptr);
+};
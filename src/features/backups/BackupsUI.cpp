@@ -1,6 +1,9 @@
 #include <Geode/modify/EditLevelLayer.hpp>
+#include <Geode/modify/LevelBrowserLayer.hpp>
+#include <Geode/binding/GJSearchObject.hpp>
 #include <Geode/ui/BasedButtonSprite.hpp>
 #include "BackupListPopup.hpp"
+#include "LostBackupsPopup.hpp"
 
 using namespace geode::prelude;
 
@@ -29,3 +32,31 @@ class $modify(BackupLevelLayer, EditLevelLayer) {
         BackupListPopup::create(m_level)->show();
     }
 };
+
+class $modify(LostBackupsLevelBrowserLayer, LevelBrowserLayer) {
+    bool init(GJSearchObject* search) {
+        if (!LevelBrowserLayer::init(search))
+            return false;
+
+        if (search->m_searchType == SearchType::MyLevels) {
+            if (auto menu = this->getChildByID("new-level-menu")) {
+                auto lostSpr = CircleButtonSprite::createWithSpriteFrameName(
+                    "backups.png"_spr, .9f, CircleBaseColor::Pink
+                );
+                lostSpr->setScale(.8f);
+                auto lostBtn = CCMenuItemSpriteExtra::create(
+                    lostSpr, this, menu_selector(LostBackupsLevelBrowserLayer::onLostBackups)
+                );
+                lostBtn->setID("lost-backups"_spr);
+                menu->addChild(lostBtn);
+                menu->updateLayout();
+            }
+        }
+
+        return true;
+    }
+
+    void onLostBackups(CCObject*) {
+        LostBackupsPopup::create()->show();
+    }
+};
@@ -0,0 +1,129 @@
+#include "ChunkStore.hpp"
+#include <Geode/utils/file.hpp>
+#include <Geode/cocos/support/zip_support/ZipUtils.h>
+#include <utils/Hash.hpp>
+#include <utils/Compression.hpp>
+
+// What the base64 of a gzip header starts with
+static constexpr std::string_view COMPRESSED_PREFIX = "H4sI";
+// A chunk is cut after an object whose hash ends in this many zero bits, 
+// which with the size limits gives chunks of a few hundred objects
+static constexpr uint64_t BOUNDARY_MASK = 0x3F;
+static constexpr size_t MIN_CHUNK_SIZE = 16 * 1024;
+static constexpr size_t MAX_CHUNK_SIZE = 256 * 1024;
+
+ChunkStore::ChunkStore(std::filesystem::path const& backupsDir)
+  : m_directory(backupsDir / DIRECTORY_NAME)
+{}
+
+Result<> ChunkStore::writeChunk(std::string_view chunk, int compressionLevel, ChunkManifest& manifest, size_t& writtenSize) {
+    // Chunks are named after their uncompressed contents, so changing the 
+    // compression level doesn't cause everything to be written again
+    auto hash = be::hashToString(be::hash64(chunk));
+    auto path = m_directory / hash;
+    if (!std::filesystem::exists(path)) {
+        // Written under a temporary name first, since a chunk cut short by 
+        // the game closing would otherwise be reused by every later backup
+        auto tempPath = m_directory / (hash + ".tmp");
+        GEODE_UNWRAP(be::writeCompressed(tempPath, chunk, compressionLevel).mapErr([](auto error) {
+            return fmt::format("Unable to save chunk: {}", error);
+        }));
+        std::error_code ec;
+        auto size = std::filesystem::file_size(tempPath, ec);
+        writtenSize += ec ? 0 : static_cast<size_t>(size);
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            return Err("Unable to save chunk: {} (code {})", ec.message(), ec.value());
+        }
+    }
+    manifest.chunks.push_back(std::move(hash));
+    return Ok();
+}
+
+Result<ChunkManifest> ChunkStore::write(
+    gd::string const& levelString, int compressionLevel, size_t& writtenSize,
+    std::function<void(float)> const& progress
+) {
+    auto manifest = ChunkManifest();
+    writtenSize = 0;
+
+    std::string data = levelString;
+    manifest.compressed = std::string_view(data).starts_with(COMPRESSED_PREFIX);
+    if (manifest.compressed) {
+        data = ZipUtils::decompressString(levelString, false, 0);
+        if (data.empty()) {
+            return Err("Unable to decompress level string");
+        }
+    }
+    manifest.size = data.size();
+
+    GEODE_UNWRAP(file::createDirectoryAll(m_directory).mapErr([](auto error) {
+        return fmt::format("Failed to create chunk directory: {}", error);
+    }));
+
+    const auto view = std::string_view(data);
+    size_t chunkStart = 0;
+    bool isHeader = true;
+    for (size_t pos = 0; pos < view.size();) {
+        auto end = view.find(';', pos);
+        end = end == std::string_view::npos ? view.size() : end + 1;
+        const auto object = view.substr(pos, end - pos);
+        pos = end;
+
+        const auto size = pos - chunkStart;
+        const bool cut =
+            // The level settings change more often than the objects, so 
+            // they get a chunk of their own
+            isHeader ||
+            pos == view.size() ||
+            size >= MAX_CHUNK_SIZE ||
+            (size >= MIN_CHUNK_SIZE && (be::hash64(object) & BOUNDARY_MASK) == 0);
+        if (cut) {
+            GEODE_UNWRAP(this->writeChunk(view.substr(chunkStart, size), compressionLevel, manifest, writtenSize));
+            chunkStart = pos;
+            isHeader = false;
+            if (progress) {
+                progress(static_cast<float>(pos) / view.size());
+            }
+        }
+    }
+
+    return Ok(manifest);
+}
+
+Result<gd::string> ChunkStore::read(ChunkManifest const& manifest) const {
+    std::string data;
+    data.reserve(manifest.size);
+    for (auto const& hash : manifest.chunks) {
+        // Decompress right onto the end of the level string
+        const auto start = data.size();
+        GEODE_UNWRAP(be::readCompressed(m_directory / hash, data).mapErr([&](auto error) {
+            return fmt::format("Unable to read chunk {}: {}", hash, error);
+        }));
+        if (be::hashToString(be::hash64(std::string_view(data).substr(start))) != hash) {
+            return Err("Chunk {} is corrupted", hash);
+        }
+    }
+    if (manifest.compressed) {
+        return Ok(ZipUtils::compressString(data, false, 0));
+    }
+    return Ok(gd::string(data));
+}
+
+Result<> ChunkStore::collectGarbage(std::vector<ChunkManifest> const& manifests) {
+    std::unordered_set<std::string> used;
+    for (auto const& manifest : manifests) {
+        used.insert(manifest.chunks.begin(), manifest.chunks.end());
+    }
+    for (auto path : file::readDirectory(m_directory).unwrapOrDefault()) {
+        if (used.contains(path.filename().string())) {
+            continue;
+        }
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (ec) {
+            return Err("Unable to delete chunk: {} (code {})", ec.message(), ec.value());
+        }
+    }
+    return Ok();
+}
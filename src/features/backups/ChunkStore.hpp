@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Geode/utils/cocos.hpp>
+
+using namespace geode::prelude;
+
+/**
+ * The list of chunks a backed up level string is made of, in order
+ */
+struct ChunkManifest final {
+    std::vector<std::string> chunks;
+    // Whether the level string was compressed and has to be compressed again 
+    // after putting it back together
+    bool compressed = false;
+    // Size of the (uncompressed) level string
+    size_t size = 0;
+};
+
+/**
+ * Stores the level strings of a level's backups split into chunks of 
+ * objects, each of which is saved only once under the hash of its contents. 
+ * Chunk boundaries are picked based on the objects themselves, so editing a 
+ * few objects only changes the chunks around them and a new backup only has 
+ * to write those. Chunks are saved compressed
+ */
+class ChunkStore final {
+public:
+    static constexpr auto DIRECTORY_NAME = "chunks";
+
+private:
+    std::filesystem::path m_directory;
+
+    Result<> writeChunk(std::string_view chunk, int compressionLevel, ChunkManifest& manifest, size_t& writtenSize);
+
+public:
+    ChunkStore(std::filesystem::path const& backupsDir);
+
+    /**
+     * Split a level string into chunks and write the ones not already stored
+     * @param compressionLevel Compression level for new chunks, from 0 to 9
+     * @param writtenSize Set to the amount of bytes of new chunks written
+     * @param progress Called with how much of the level has been written so 
+     * far, from 0 to 1
+     */
+    Result<ChunkManifest> write(
+        gd::string const& levelString, int compressionLevel, size_t& writtenSize,
+        std::function<void(float)> const& progress = nullptr
+    );
+    /**
+     * Put a level string back together from its chunks
+     */
+    Result<gd::string> read(ChunkManifest const& manifest) const;
+    /**
+     * Delete every chunk that isn't used by any of the given manifests
+     */
+    Result<> collectGarbage(std::vector<ChunkManifest> const& manifests);
+};
@@ -0,0 +1,448 @@
+#include "EditJournal.hpp"
+#include "BackupWorker.hpp"
+#include <Geode/modify/LevelEditorLayer.hpp>
+#include <Geode/modify/EditorUI.hpp>
+#include <Geode/modify/GameObject.hpp>
+#include <Geode/binding/LevelSettingsObject.hpp>
+#include <Geode/cocos/support/zip_support/ZipUtils.h>
+#include <Geode/utils/file.hpp>
+#include <cvolton.level-id-api/include/EditorIDs.hpp>
+#include <utils/Editor.hpp>
+#include <utils/Hash.hpp>
+#include <utils/LevelDiff.hpp>
+#include <charconv>
+#include <fstream>
+
+// Journals start with this followed by the hash of their checkpoint
+static constexpr std::string_view JOURNAL_MAGIC = "BEJ1 ";
+// Every record is one line starting with one of these
+static constexpr char RECORD_ADD = '+';
+static constexpr char RECORD_REMOVE = '-';
+static constexpr char RECORD_SETTINGS = 'S';
+
+static EditJournal* ACTIVE_JOURNAL = nullptr;
+
+static uint64_t hashString(gd::string const& str) {
+    return be::hash64(std::string_view(str.c_str(), str.size()));
+}
+
+class $modify(JournalEditorLayer, LevelEditorLayer) {
+    struct Fields {
+        std::unique_ptr<EditJournal> journal;
+    };
+
+    $override
+    bool init(GJGameLevel* level, bool p1) {
+        if (!LevelEditorLayer::init(level, p1))
+            return false;
+
+        // Started on the first frame, since whether this is a view-only 
+        // editor isn't known until after it has been created
+        this->schedule(schedule_selector(JournalEditorLayer::onJournalSweep));
+        this->schedule(schedule_selector(JournalEditorLayer::onJournalFlush), EditJournal::FLUSH_INTERVAL);
+
+        return true;
+    }
+
+    void onJournalSweep(float) {
+        if (!m_fields->journal) {
+            if (be::isViewOnlyEditor(this)) {
+                this->unschedule(schedule_selector(JournalEditorLayer::onJournalSweep));
+                this->unschedule(schedule_selector(JournalEditorLayer::onJournalFlush));
+                return;
+            }
+            m_fields->journal = std::make_unique<EditJournal>(this);
+        }
+        if (m_fields->journal->isRecording()) {
+            m_fields->journal->sweep(EditJournal::OBJECTS_SWEPT_PER_FRAME);
+        }
+    }
+    void onJournalFlush(float) {
+        if (auto journal = this->getRecordingJournal()) {
+            journal->flush();
+        }
+    }
+
+    // Null while the editor is still loading or playtesting
+    EditJournal* getRecordingJournal() {
+        auto journal = m_fields->journal.get();
+        return journal && journal->isRecording() ? journal : nullptr;
+    }
+
+    $override
+    GameObject* createObject(int id, CCPoint pos, bool p2) {
+        auto obj = LevelEditorLayer::createObject(id, pos, p2);
+        if (auto journal = this->getRecordingJournal(); obj && journal) {
+            journal->onCreated(obj);
+        }
+        return obj;
+    }
+    $override
+    CCArray* createObjectsFromString(gd::string const& str, bool p1, bool p2) {
+        auto objs = LevelEditorLayer::createObjectsFromString(str, p1, p2);
+        if (auto journal = this->getRecordingJournal(); objs && journal) {
+            for (auto obj : CCArrayExt<GameObject*>(objs)) {
+                journal->onCreated(obj);
+            }
+        }
+        return objs;
+    }
+    $override
+    void removeObject(GameObject* obj, bool p1) {
+        if (auto journal = this->getRecordingJournal()) {
+            journal->willRemove(obj);
+        }
+        LevelEditorLayer::removeObject(obj, p1);
+    }
+};
+
+static EditJournal* getRecordingJournal(LevelEditorLayer* lel) {
+    return static_cast<JournalEditorLayer*>(lel)->getRecordingJournal();
+}
+
+// Objects edited through popups are almost always selected first, and 
+// deselected once done
+class $modify(EditorUI) {
+    $override
+    void selectObject(GameObject* obj, bool filter) {
+        if (auto journal = getRecordingJournal(m_editorLayer); obj && journal) {
+            journal->willChange(obj);
+        }
+        EditorUI::selectObject(obj, filter);
+    }
+    $override
+    void selectObjects(CCArray* objs, bool ignoreFilters) {
+        if (auto journal = getRecordingJournal(m_editorLayer); objs && journal) {
+            for (auto obj : CCArrayExt<GameObject*>(objs)) {
+                journal->willChange(obj);
+            }
+        }
+        EditorUI::selectObjects(objs, ignoreFilters);
+    }
+    $override
+    void deselectObject(GameObject* obj) {
+        if (auto journal = getRecordingJournal(m_editorLayer); obj && journal) {
+            journal->markDirty(obj);
+        }
+        EditorUI::deselectObject(obj);
+    }
+    $override
+    void deselectAll() {
+        if (auto journal = getRecordingJournal(m_editorLayer)) {
+            if (m_selectedObject) {
+                journal->markDirty(m_selectedObject);
+            }
+            for (auto obj : CCArrayExt<GameObject*>(m_selectedObjects)) {
+                journal->markDirty(obj);
+            }
+        }
+        EditorUI::deselectAll();
+    }
+};
+
+// These are called a lot (also outside the editor), so they only ever do a 
+// lookup
+class $modify(GameObject) {
+    $override
+    void setPosition(CCPoint const& pos) {
+        GameObject::setPosition(pos);
+        if (auto journal = EditJournal::get(); journal && journal->isRecording()) {
+            journal->markDirty(this);
+        }
+    }
+    $override
+    void setRotation(float rotation) {
+        GameObject::setRotation(rotation);
+        if (auto journal = EditJournal::get(); journal && journal->isRecording()) {
+            journal->markDirty(this);
+        }
+    }
+    $override
+    void setScaleX(float scale) {
+        GameObject::setScaleX(scale);
+        if (auto journal = EditJournal::get(); journal && journal->isRecording()) {
+            journal->markDirty(this);
+        }
+    }
+    $override
+    void setScaleY(float scale) {
+        GameObject::setScaleY(scale);
+        if (auto journal = EditJournal::get(); journal && journal->isRecording()) {
+            journal->markDirty(this);
+        }
+    }
+};
+
+EditJournal::EditJournal(LevelEditorLayer* editor)
+  : m_editor(editor), m_path(getJournalPath(editor->m_level))
+{
+    ACTIVE_JOURNAL = this;
+
+    // The objects were just loaded from the level string, so their recorded 
+    // versions can be taken straight from it rather than by saving every 
+    // object again
+    if (auto level = be::decompressLevelString(editor->m_level->m_levelString)) {
+        const auto records = be::parseLevelObjects(level.unwrap());
+        std::vector<int> objectIDs;
+        objectIDs.reserve(records.size());
+        for (auto const& record : records) {
+            objectIDs.push_back(record.objectID);
+        }
+        m_recorded.reserve(records.size());
+        be::forEachObjectByStringIndex(editor, objectIDs, [&](GameObject* obj, size_t index) {
+            if (index < records.size()) {
+                m_recorded.emplace(obj, records[index].hash);
+            }
+        });
+        m_settingsHash = be::hash64(be::getLevelSettings(level.unwrap()));
+    }
+    // Objects that couldn't be lined up with the level string are saved to 
+    // get their hash instead, since a wrong one would make replaying remove 
+    // some other object
+    for (auto obj : CCArrayExt<GameObject*>(editor->m_objects)) {
+        if (!m_recorded.contains(obj)) {
+            m_recorded.emplace(obj, this->hashObject(obj));
+        }
+    }
+    this->checkpoint();
+}
+EditJournal::~EditJournal() {
+    if (ACTIVE_JOURNAL == this) {
+        ACTIVE_JOURNAL = nullptr;
+    }
+    // If the same level was opened again before this editor got destroyed, 
+    // the file now belongs to the new editor's journal
+    else if (ACTIVE_JOURNAL && ACTIVE_JOURNAL->m_path == m_path) {
+        return;
+    }
+    // The editor was closed normally, so there is nothing to recover. Done 
+    // on the worker so no writes still queued there can bring the file back
+    BackupWorker::get()->submit([path = m_path](auto const&) -> Result<> {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return Ok();
+    });
+}
+
+EditJournal* EditJournal::get() {
+    return ACTIVE_JOURNAL;
+}
+std::filesystem::path EditJournal::getJournalDir() {
+    return Mod::get()->getSaveDir() / "journal";
+}
+std::filesystem::path EditJournal::getJournalPath(GJGameLevel* level) {
+    return getJournalDir() / fmt::format("{}.journal", EditorIDs::getID(level));
+}
+std::filesystem::path const& EditJournal::getPath() const {
+    return m_path;
+}
+
+bool EditJournal::isRecording() const {
+    // Playtesting moves objects around and puts them back afterwards
+    return m_editor->m_playbackMode == PlaybackMode::Not;
+}
+uint64_t EditJournal::hashObject(GameObject* obj) const {
+    return hashString(obj->getSaveString(m_editor));
+}
+void EditJournal::write(std::string&& data, bool truncate) {
+    BackupWorker::get()->submit([path = m_path, data = std::move(data), truncate](auto const&) -> Result<> {
+        GEODE_UNWRAP(file::createDirectoryAll(path.parent_path()));
+        auto stream = std::ofstream(path, std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+        if (!stream) {
+            return Err("Unable to open edit journal");
+        }
+        stream.write(data.data(), data.size());
+        stream.flush();
+        if (!stream) {
+            return Err("Unable to write to edit journal");
+        }
+        return Ok();
+    }, nullptr, [](Result<> res) {
+        if (!res) {
+            log::error("{}", res.unwrapErr());
+        }
+    });
+}
+
+void EditJournal::checkpoint() {
+    // Everything so far is in the checkpoint, but the recorded hashes of 
+    // dirty objects still have to be brought up to date
+    this->collectChanges();
+    m_pending.clear();
+    this->write(fmt::format(
+        "{}{}\n", JOURNAL_MAGIC, be::hashToString(hashString(m_editor->m_level->m_levelString))
+    ), true);
+}
+
+void EditJournal::willChange(GameObject* obj) {
+    if (!m_recorded.contains(obj) && !m_removed.contains(obj)) {
+        m_recorded.emplace(obj, this->hashObject(obj));
+    }
+    m_dirty.insert(obj);
+}
+void EditJournal::markDirty(GameObject* obj) {
+    if (m_recorded.contains(obj)) {
+        m_dirty.insert(obj);
+    }
+}
+void EditJournal::willRemove(GameObject* obj) {
+    uint64_t hash;
+    if (auto it = m_recorded.find(obj); it != m_recorded.end()) {
+        hash = it->second;
+        m_recorded.erase(it);
+    }
+    else if (!m_removed.contains(obj)) {
+        hash = this->hashObject(obj);
+    }
+    else {
+        return;
+    }
+    if (hash != NOT_RECORDED) {
+        m_pending += fmt::format("{}{}\n", RECORD_REMOVE, be::hashToString(hash));
+    }
+    m_dirty.erase(obj);
+    m_removed.insert(obj);
+}
+void EditJournal::onCreated(GameObject* obj) {
+    m_removed.erase(obj);
+    m_recorded[obj] = NOT_RECORDED;
+    m_dirty.insert(obj);
+}
+
+void EditJournal::sweep(size_t count) {
+    const auto objs = m_editor->m_objects;
+    if (m_sweepIndex >= objs->count()) {
+        m_sweepIndex = 0;
+    }
+    for (size_t i = 0; i < count && m_sweepIndex < objs->count(); i += 1, m_sweepIndex += 1) {
+        auto obj = static_cast<GameObject*>(objs->objectAtIndex(m_sweepIndex));
+        auto it = m_recorded.find(obj);
+        // Added back by something like undoing a deletion
+        if (it == m_recorded.end()) {
+            this->onCreated(obj);
+        }
+        else if (!m_dirty.contains(obj) && this->hashObject(obj) != it->second) {
+            m_dirty.insert(obj);
+        }
+    }
+}
+void EditJournal::collectChanges() {
+    for (auto obj : m_dirty) {
+        auto it = m_recorded.find(obj);
+        if (it == m_recorded.end()) {
+            continue;
+        }
+        auto str = obj->getSaveString(m_editor);
+        auto hash = hashString(str);
+        if (hash == it->second) {
+            continue;
+        }
+        if (it->second != NOT_RECORDED) {
+            m_pending += fmt::format("{}{}\n", RECORD_REMOVE, be::hashToString(it->second));
+        }
+        m_pending += RECORD_ADD;
+        m_pending.append(str.c_str(), str.size());
+        m_pending += '\n';
+        it->second = hash;
+    }
+    m_dirty.clear();
+
+    auto settings = m_editor->m_levelSettings->getSaveString();
+    if (auto hash = hashString(settings); hash != m_settingsHash) {
+        m_pending += RECORD_SETTINGS;
+        m_pending.append(settings.c_str(), settings.size());
+        m_pending += '\n';
+        m_settingsHash = hash;
+    }
+}
+void EditJournal::flush() {
+    this->collectChanges();
+    if (!m_pending.empty()) {
+        this->write(std::move(m_pending), false);
+        m_pending.clear();
+    }
+}
+
+Result<gd::string> EditJournal::replay(std::filesystem::path const& path, std::vector<gd::string> const& checkpoints) {
+    GEODE_UNWRAP_INTO(auto data, file::readString(path));
+    auto journal = std::string_view(data);
+
+    auto headerEnd = journal.find('\n');
+    if (headerEnd == std::string_view::npos || !journal.starts_with(JOURNAL_MAGIC)) {
+        return Err("Journal has no header");
+    }
+    const auto checkpointHash = journal.substr(JOURNAL_MAGIC.size(), headerEnd - JOURNAL_MAGIC.size());
+    journal.remove_prefix(headerEnd + 1);
+
+    auto checkpoint = std::find_if(checkpoints.begin(), checkpoints.end(), [&](auto const& str) {
+        return be::hashToString(hashString(str)) == checkpointHash;
+    });
+    if (checkpoint == checkpoints.end()) {
+        return Err("The level the journal was started from no longer exists");
+    }
+    GEODE_UNWRAP_INTO(auto level, be::decompressLevelString(*checkpoint));
+
+    auto settings = be::getLevelSettings(level);
+    std::vector<std::string_view> objects;
+    for (auto const& record : be::parseLevelObjects(level)) {
+        objects.push_back(std::string_view(level).substr(record.offset, record.length));
+    }
+    std::vector<bool> alive(objects.size(), true);
+    std::unordered_map<uint64_t, std::vector<size_t>> objectsByHash;
+    for (size_t i = 0; i < objects.size(); i += 1) {
+        objectsByHash[be::hash64(objects[i])].push_back(i);
+    }
+
+    // A line without a newline at the end was cut off by the crash
+    size_t replayed = 0;
+    for (auto lineEnd = journal.find('\n'); lineEnd != std::string_view::npos; lineEnd = journal.find('\n')) {
+        const auto line = journal.substr(0, lineEnd);
+        journal.remove_prefix(lineEnd + 1);
+        if (line.empty()) {
+            continue;
+        }
+        const auto value = line.substr(1);
+        switch (line.front()) {
+            case RECORD_ADD: {
+                objectsByHash[be::hash64(value)].push_back(objects.size());
+                objects.push_back(value);
+                alive.push_back(true);
+            } break;
+
+            case RECORD_REMOVE: {
+                uint64_t hash;
+                auto [_, err] = std::from_chars(value.data(), value.data() + value.size(), hash, 16);
+                auto it = objectsByHash.find(hash);
+                if (err != std::errc() || it == objectsByHash.end() || it->second.empty()) {
+                    log::warn("Edit journal removes an object that doesn't exist");
+                    continue;
+                }
+                alive[it->second.back()] = false;
+                it->second.pop_back();
+            } break;
+
+            case RECORD_SETTINGS: {
+                settings = value;
+            } break;
+
+            default: {
+                log::warn("Unknown record in edit journal");
+                continue;
+            }
+        }
+        replayed += 1;
+    }
+    log::info("Replayed {} records from edit journal", replayed);
+
+    std::string result;
+    result.reserve(level.size() + data.size());
+    result.append(settings);
+    result.push_back(';');
+    for (size_t i = 0; i < objects.size(); i += 1) {
+        if (alive[i]) {
+            result.append(objects[i]);
+            result.push_back(';');
+        }
+    }
+    return Ok(ZipUtils::compressString(result, false, 0));
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Geode/binding/LevelEditorLayer.hpp>
+#include <Geode/binding/GameObject.hpp>
+
+using namespace geode::prelude;
+
+/**
+ * Append-only journal of the changes made in the editor since the level 
+ * was last saved, so crash recovery doesn't lose everything done since the 
+ * last quicksave or autosave. 
+ * 
+ * Objects are identified by the hash of their object string, so changing an 
+ * object is recorded as the old version being removed and the new one being 
+ * added. This means replaying the journal onto the level string it was 
+ * started from (its checkpoint) doesn't need to know anything about the 
+ * editor's objects. 
+ * 
+ * Hooks mark the objects that are being edited as dirty, and a sweep through 
+ * the level catches changes the hooks miss. Dirty objects are written out 
+ * on the backup worker every `FLUSH_INTERVAL` seconds
+ */
+class EditJournal final {
+public:
+    static constexpr float FLUSH_INTERVAL = 1.f;
+    static constexpr size_t OBJECTS_SWEPT_PER_FRAME = 100;
+
+protected:
+    // Hash for objects that are in neither the checkpoint nor the journal yet
+    static constexpr uint64_t NOT_RECORDED = 0;
+
+    LevelEditorLayer* m_editor;
+    std::filesystem::path m_path;
+    // Hash of every object's string as it is in the checkpoint and journal
+    std::unordered_map<GameObject*, uint64_t> m_recorded;
+    // Removed objects may be brought back by undoing
+    std::unordered_set<GameObject*> m_removed;
+    std::unordered_set<GameObject*> m_dirty;
+    uint64_t m_settingsHash = 0;
+    std::string m_pending;
+    size_t m_sweepIndex = 0;
+
+    uint64_t hashObject(GameObject* obj) const;
+    void write(std::string&& data, bool truncate);
+    // Turn everything that has changed into records in `m_pending`
+    void collectChanges();
+
+public:
+    EditJournal(LevelEditorLayer* editor);
+    ~EditJournal();
+
+    EditJournal(EditJournal const&) = delete;
+    EditJournal& operator=(EditJournal const&) = delete;
+
+    /**
+     * Get the journal of the current editor, or null if there isn't one
+     */
+    static EditJournal* get();
+    static std::filesystem::path getJournalDir();
+    static std::filesystem::path getJournalPath(GJGameLevel* level);
+    std::filesystem::path const& getPath() const;
+    /**
+     * Replay a journal onto its checkpoint. The checkpoint is whichever of 
+     * `checkpoints` the journal was started from
+     */
+    static Result<gd::string> replay(std::filesystem::path const& path, std::vector<gd::string> const& checkpoints);
+
+    /**
+     * Whether changes are currently being recorded (they aren't while 
+     * playtesting)
+     */
+    bool isRecording() const;
+
+    /**
+     * Start the journal over from the level's current level string. Should 
+     * be called after the level string has been saved somewhere it will be 
+     * found by crash recovery
+     */
+    void checkpoint();
+    /**
+     * Called before an object gets edited
+     */
+    void willChange(GameObject* obj);
+    /**
+     * Called when an object that may have been edited was already known to 
+     * the journal. Much cheaper than `willChange` for objects it doesn't know
+     */
+    void markDirty(GameObject* obj);
+    void willRemove(GameObject* obj);
+    void onCreated(GameObject* obj);
+    /**
+     * Check the next `count` objects in the level for changes
+     */
+    void sweep(size_t count);
+    /**
+     * Write every change since the last flush to the journal
+     */
+    void flush();
+};
@@ -0,0 +1,207 @@
+#include "LostBackupsPopup.hpp"
+#include "BackupWorker.hpp"
+#include <Geode/ui/Scrollbar.hpp>
+#include <Geode/ui/General.hpp>
+#include <Geode/binding/LocalLevelManager.hpp>
+#include <cvolton.level-id-api/include/EditorIDs.hpp>
+#include <fmt/chrono.h>
+
+bool LostLevelItem::init(BackupCatalog::CatalogLevel const& level) {
+    if (!CCNode::init())
+        return false;
+
+    this->setContentSize({ 275, 35 });
+
+    m_level = level;
+
+    auto bg = CCScale9Sprite::create("square02c_001.png");
+    bg->setColor({ 25, 25, 25 });
+    bg->setOpacity(90);
+    bg->setScale(.5f);
+    bg->setContentSize(m_obContentSize / bg->getScale());
+    this->addChildAtPosition(bg, Anchor::Center);
+
+    auto title = CCLabelBMFont::create(level.name.c_str(), "bigFont.fnt");
+    title->setAnchorPoint({ 0, .5f });
+    title->setScale(.5f);
+    this->addChildAtPosition(title, Anchor::Left, ccp(5, 7));
+
+    auto info = CCLabelBMFont::create(fmt::format(
+        "{} backups | latest {:%Y/%m/%d at %H:%M}",
+        level.backups.size(), level.backups.front().meta.createTime
+    ).c_str(), "goldFont.fnt");
+    info->setAnchorPoint({ 0, .5f });
+    info->setScale(.4f);
+    this->addChildAtPosition(info, Anchor::Left, ccp(5, -7));
+
+    if (level.restored) {
+        auto restoredLabel = CCLabelBMFont::create("Restored", "bigFont.fnt");
+        restoredLabel->setAnchorPoint({ 1, .5f });
+        restoredLabel->setScale(.4f);
+        restoredLabel->setColor({ 125, 255, 125 });
+        this->addChildAtPosition(restoredLabel, Anchor::Right, ccp(-10, 0));
+        return true;
+    }
+
+    auto menu = CCMenu::create();
+    menu->setAnchorPoint({ 1, .5f });
+    menu->setContentWidth(100);
+
+    auto restoreSpr = CCSprite::createWithSpriteFrameName("GJ_undoBtn_001.png");
+    auto restoreBtn = CCMenuItemSpriteExtra::create(
+        restoreSpr, this, menu_selector(LostLevelItem::onRestore)
+    );
+    menu->addChild(restoreBtn);
+
+    menu->setLayout(
+        RowLayout::create()
+            ->setAxisReverse(true)
+            ->setAxisAlignment(AxisAlignment::End)
+            ->setDefaultScaleLimits(.1f, .55f)
+    );
+    this->addChildAtPosition(menu, Anchor::Right, ccp(-5, 0));
+
+    return true;
+}
+
+void LostLevelItem::onRestore(CCObject*) {
+    createQuickPopup(
+        "Restore Level",
+        fmt::format(
+            "Do you want to <cy>restore {}</c> from its latest backup?\n"
+            "It will be added to your created levels as a new level.",
+            m_level.name
+        ),
+        "Cancel", "Restore",
+        [this](auto*, bool btn2) {
+            if (!btn2) {
+                return;
+            }
+            auto directory = m_level.backups.front().directory;
+            auto backup = Backup::load(directory, nullptr);
+            if (!backup) {
+                FLAlertLayer::create(
+                    "Unable to Restore Level",
+                    fmt::format("Unable to load backup: {}", backup.unwrapErr()),
+                    "OK"
+                )->show();
+                return;
+            }
+            auto level = backup.unwrap()->loadLevel();
+            if (!level) {
+                FLAlertLayer::create(
+                    "Unable to Restore Level",
+                    fmt::format("Unable to load backup: {}", level.unwrapErr()),
+                    "OK"
+                )->show();
+                return;
+            }
+            level.unwrap()->m_levelType = GJLevelType::Editor;
+            LocalLevelManager::get()->m_localLevels->insertObject(level.unwrap(), 0);
+            FLAlertLayer::create(
+                "Level Restored",
+                fmt::format("<cy>{}</c> has been added to your created levels.", m_level.name),
+                "OK"
+            )->show();
+
+            // Remember the restore so the level isn't offered again, even 
+            // after the popup is reopened
+            BackupWorker::get()->submit([directory](auto const&) -> Result<> {
+                BackupCatalog::recordRestored(directory);
+                return Ok();
+            });
+            // This rebuilds the list, which removes this item
+            LostLevelRestoredEvent(m_level.levelID).post();
+        }
+    );
+}
+
+LostLevelItem* LostLevelItem::create(BackupCatalog::CatalogLevel const& level) {
+    auto ret = new LostLevelItem();
+    if (ret && ret->init(level)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+bool LostBackupsPopup::setup() {
+    this->setTitle("Lost Backups");
+
+    auto bg = CCLayerColor::create({ 130, 64, 32, 255 });
+    bg->ignoreAnchorPointForPosition(false);
+    m_mainLayer->addChildAtPosition(bg, Anchor::Center);
+
+    m_scrollLayer = ScrollLayer::create({ 275, 190 });
+    m_scrollLayer->m_contentLayer->setLayout(
+        ColumnLayout::create()
+            ->setGap(2)
+            ->setAxisReverse(true)
+            ->setAxisAlignment(AxisAlignment::End)
+            ->setAutoGrowAxis(m_scrollLayer->getContentHeight())
+    );
+    m_mainLayer->addChildAtPosition(m_scrollLayer, Anchor::Center, -m_scrollLayer->getContentSize() / 2);
+
+    bg->setContentSize(m_scrollLayer->getContentSize() + ccp(10, 10));
+
+    auto borders = ListBorders::create();
+    borders->setContentSize(m_scrollLayer->getContentSize() + ccp(10, 10));
+    m_mainLayer->addChildAtPosition(borders, Anchor::Center);
+
+    auto scrollbar = Scrollbar::create(m_scrollLayer);
+    m_mainLayer->addChildAtPosition(scrollbar, Anchor::Center, ccp(m_scrollLayer->getContentWidth() / 2 + 15, 0));
+
+    m_statusLabel = CCLabelBMFont::create("Loading...", "bigFont.fnt");
+    m_statusLabel->setScale(.5f);
+    m_statusLabel->setOpacity(205);
+    m_mainLayer->addChildAtPosition(m_statusLabel, Anchor::Center);
+
+    m_restoredListener.bind([this](LostLevelRestoredEvent* ev) {
+        for (auto& level : m_levels) {
+            if (level.levelID == ev->levelID) {
+                level.restored = true;
+            }
+        }
+        this->updateList();
+        return ListenerResult::Propagate;
+    });
+
+    // The catalog lists every backup, so this doesn't need to look through 
+    // any backup folders. The first time it's loaded it has to be built by 
+    // scanning them though, which is done on the worker
+    auto levels = std::make_shared<std::vector<BackupCatalog::CatalogLevel>>();
+    BackupWorker::get()->submit([levels](auto const&) -> Result<> {
+        *levels = BackupCatalog::load();
+        return Ok();
+    }, nullptr, [popup = Ref<LostBackupsPopup>(this), levels](Result<>) {
+        popup->m_levels = std::move(*levels);
+        popup->updateList();
+    });
+
+    this->addCorners(Corner::Brown, Corner::Gold);
+
+    return true;
+}
+
+void LostBackupsPopup::updateList() {
+    m_scrollLayer->m_contentLayer->removeAllChildren();
+    for (auto const& level : m_levels) {
+        if (!EditorIDs::getLevelByID(level.levelID)) {
+            m_scrollLayer->m_contentLayer->addChild(LostLevelItem::create(level));
+        }
+    }
+    m_statusLabel->setString("No Lost Backups Found");
+    m_statusLabel->setVisible(m_scrollLayer->m_contentLayer->getChildrenCount() == 0);
+    m_scrollLayer->m_contentLayer->updateLayout();
+}
+
+LostBackupsPopup* LostBackupsPopup::create() {
+    auto ret = new LostBackupsPopup();
+    if (ret && ret->initAnchored(350, 270)) {
+        ret->autorelease();
+        return ret;
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Geode/ui/Popup.hpp>
+#include <Geode/ui/ScrollLayer.hpp>
+#include "BackupCatalog.hpp"
+#include <utils/PopupWithCorners.hpp>
+
+using namespace geode::prelude;
+
+struct LostLevelRestoredEvent : public Event {
+    int levelID;
+    LostLevelRestoredEvent(int levelID) : levelID(levelID) {}
+};
+
+/**
+ * A level that has backups but no longer exists, for example because it was 
+ * deleted or its save data was lost
+ */
+class LostLevelItem : public CCNode {
+protected:
+    BackupCatalog::CatalogLevel m_level;
+
+    bool init(BackupCatalog::CatalogLevel const& level);
+
+    void onRestore(CCObject*);
+
+public:
+    static LostLevelItem* create(BackupCatalog::CatalogLevel const& level);
+};
+
+class LostBackupsPopup : public PopupWithCorners<> {
+protected:
+    ScrollLayer* m_scrollLayer;
+    CCLabelBMFont* m_statusLabel;
+    std::vector<BackupCatalog::CatalogLevel> m_levels;
+    EventListener<EventFilter<LostLevelRestoredEvent>> m_restoredListener;
+
+    bool setup() override;
+    void updateList();
+
+public:
+    static LostBackupsPopup* create();
+};
@@ -1,4 +1,7 @@
 #include "QuickSave.hpp"
+#include "Backup.hpp"
+#include "BackupWorker.hpp"
+#include "EditJournal.hpp"
 #include <Geode/modify/EditorPauseLayer.hpp>
 #include <Geode/modify/GManager.hpp>
 #include <Geode/modify/MenuLayer.hpp>
@@ -8,6 +11,7 @@
 #include <hjfod.gmd-api/include/GMD.hpp>
 #include <utils/HolyUB.hpp>
 #include <utils/Editor.hpp>
+#include <utils/Hash.hpp>
 
 using namespace geode::prelude;
 
@@ -21,6 +25,100 @@ static std::filesystem::path getAutoSaveDir() {
     return Mod::get()->getSaveDir() / "autosave";
 }
 
+// The level string is saved next to the level file rather than in it so it 
+// can be written on the backup worker instead of freezing the editor
+static std::filesystem::path getLevelStringPath(std::filesystem::path const& levelFile) {
+    return std::filesystem::path(levelFile).replace_extension(".level");
+}
+// Hashes of the level strings last written to each level string file, so 
+// saving a level that hasn't changed doesn't write the whole thing again
+static std::unordered_map<std::string, uint64_t> WRITTEN_LEVEL_STRINGS;
+
+// Level strings may still be queued for writing on the worker, so they are 
+// removed there too to make sure none of them end up being written after
+static void removeLevelStrings(std::vector<std::filesystem::path>&& paths) {
+    for (auto const& path : paths) {
+        WRITTEN_LEVEL_STRINGS.erase(path.string());
+    }
+    BackupWorker::get()->submit([paths = std::move(paths)](auto const&) -> Result<> {
+        for (auto const& path : paths) {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+        return Ok();
+    });
+}
+static void removeCrashData(std::filesystem::path const& dir) {
+    std::vector<std::filesystem::path> levelStrings;
+    for (auto file : file::readDirectory(dir).unwrapOrDefault()) {
+        if (file.extension() == ".gmd") {
+            levelStrings.push_back(getLevelStringPath(file));
+        }
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    removeLevelStrings(std::move(levelStrings));
+}
+
+// Save the level to a crash data directory. The level string itself is 
+// written on the backup worker
+static Result<> saveCrashData(GJGameLevel* level, std::filesystem::path const& dir) {
+    auto path = dir / fmt::format("{}.gmd", EditorIDs::getID(level));
+    (void)file::createDirectoryAll(dir);
+    GEODE_UNWRAP(exportLevelSettings(level, path));
+
+    auto levelStringPath = getLevelStringPath(path);
+    auto hash = be::hash64(std::string_view(level->m_levelString.c_str(), level->m_levelString.size()));
+    auto [written, inserted] = WRITTEN_LEVEL_STRINGS.try_emplace(levelStringPath.string(), hash);
+    if (!inserted && written->second == hash) {
+        log::debug("Level '{}' hasn't changed since it was last saved, not writing it again", level->m_levelName);
+        return Ok();
+    }
+    written->second = hash;
+
+    BackupWorker::get()->submit(
+        [path = levelStringPath, levelString = std::string(level->m_levelString)](auto const&) -> Result<> {
+            // Written under a temporary name first so a crash mid-write 
+            // can't leave behind a cut-off level string
+            auto tempPath = path;
+            tempPath += ".tmp";
+            GEODE_UNWRAP(file::writeString(tempPath, levelString));
+            std::error_code ec;
+            std::filesystem::rename(tempPath, path, ec);
+            if (ec) {
+                return Err("Unable to save level string: {} (code {})", ec.message(), ec.value());
+            }
+            return Ok();
+        },
+        nullptr,
+        [name = std::string(level->m_levelName), key = levelStringPath.string()](Result<> res) {
+            if (!res) {
+                log::error("Unable to save level '{}': {}", name, res.unwrapErr());
+                WRITTEN_LEVEL_STRINGS.erase(key);
+            }
+        }
+    );
+    return Ok();
+}
+
+// The game may save while a level is open in the editor, and that level's 
+// journal still has everything since its last checkpoint, so it's kept
+static void removeJournals() {
+    std::filesystem::path activePath;
+    if (auto journal = EditJournal::get()) {
+        activePath = journal->getPath();
+    }
+    BackupWorker::get()->submit([activePath = std::move(activePath)](auto const&) -> Result<> {
+        for (auto file : file::readDirectory(EditJournal::getJournalDir()).unwrapOrDefault()) {
+            if (file != activePath) {
+                std::error_code ec;
+                std::filesystem::remove(file, ec);
+            }
+        }
+        return Ok();
+    });
+}
+
 static bool CREATING_AUTO_SAVE = false;
 void createAutoSave(LevelEditorLayer* lel) {
     CREATING_AUTO_SAVE = true;
@@ -40,9 +138,9 @@ class $modify(GManager) {
         GManager::save();
         // If we have succesfully saved local levels, we can delete the temp quick save directory
         if (isLLM) {
-            std::error_code ec;
-            std::filesystem::remove_all(getQuickSaveDir(), ec);
-            std::filesystem::remove_all(getAutoSaveDir(), ec);
+            removeCrashData(getQuickSaveDir());
+            removeCrashData(getAutoSaveDir());
+            removeJournals();
         }
 	}
 };
@@ -60,13 +158,17 @@ class $modify(EditorPauseLayer) {
         CREATING_AUTO_SAVE = false;
 
         // Save to individual file regardless as a backup if saving crashes
-        (void)file::createDirectoryAll(dir);
-        auto res = gmd::exportLevelAsGmd(
-            m_editorLayer->m_level,
-            dir / fmt::format("{}.gmd", EditorIDs::getID(m_editorLayer->m_level))
-        );
+        auto level = m_editorLayer->m_level;
+        auto res = saveCrashData(level, dir);
         if (!res) {
-            log::error("Unable to save level '{}': {}", m_editorLayer->m_level->m_levelName, res.unwrapErr());
+            log::error("Unable to save level '{}': {}", level->m_levelName, res.unwrapErr());
+            return;
+        }
+
+        // Everything up to now is in the crash data, so the journal can start 
+        // over from it
+        if (auto journal = EditJournal::get()) {
+            journal->checkpoint();
         }
     }
 
@@ -79,11 +181,10 @@ class $modify(EditorPauseLayer) {
         // Discard autosaves on exit without save
         if (fl->getTag() == 1 && btn2) {
             log::warn("Discarding autosaved changes");
+            auto path = getAutoSaveDir() / fmt::format("{}.gmd", EditorIDs::getID(m_editorLayer->m_level));
             std::error_code ec;
-            std::filesystem::remove_all(
-                getAutoSaveDir() / fmt::format("{}.gmd", EditorIDs::getID(m_editorLayer->m_level)),
-                ec
-            );
+            std::filesystem::remove_all(path, ec);
+            removeLevelStrings({ getLevelStringPath(path) });
         }
         EditorPauseLayer::FLAlert_Clicked(fl, btn2);
     }
@@ -123,16 +224,67 @@ class $modify(MenuLayer) {
         // Important: Load Quick Saved crash data *after* autosaved crash data, 
         // as quick saved data is always more up-to-date
         restoreCrashData(getQuickSaveDir());
+
+        // Journals have the changes made after the crash data was saved
+        restoreJournals();
         
         return true;
     }
 
+    static void restoreJournals() {
+        for (auto path : file::readDirectory(EditJournal::getJournalDir()).unwrapOrDefault()) {
+            if (path.extension() != ".journal") continue;
+            auto num = numFromString<int>(path.stem().string());
+            auto level = num ? EditorIDs::getLevelByID(*num) : nullptr;
+            if (!level) continue;
+
+            // The journal was started from either the saved level or from 
+            // one of its crash data files
+            std::vector<gd::string> checkpoints { level->m_levelString };
+            for (auto const& dir : { getQuickSaveDir(), getAutoSaveDir() }) {
+                auto levelStringPath = getLevelStringPath(dir / fmt::format("{}.gmd", *num));
+                if (auto levelString = geode::utils::file::readString(levelStringPath)) {
+                    checkpoints.push_back(levelString.unwrap());
+                }
+            }
+            auto res = EditJournal::replay(path, checkpoints);
+            if (!res) {
+                log::warn("Unable to replay edit journal for {}: {}", level->m_levelName, res.unwrapErr());
+                continue;
+            }
+            level->m_levelString = res.unwrap();
+            log::info("Replayed edit journal for {}", level->m_levelName);
+
+            // The replayed level only exists in memory until the game saves, 
+            // so it becomes the new crash data in place of the journal
+            if (auto saved = saveCrashData(level, getQuickSaveDir()); !saved) {
+                log::error("Unable to save replayed level '{}': {}", level->m_levelName, saved.unwrapErr());
+                continue;
+            }
+            BackupWorker::get()->submit([path](auto const&) -> Result<> {
+                std::error_code ec;
+                std::filesystem::remove(path, ec);
+                return Ok();
+            });
+        }
+    }
+
     static void restoreCrashData(std::filesystem::path const& path) {
         for (auto file : file::readDirectory(path).unwrapOrDefault()) {
+            if (file.extension() != ".gmd") continue;
             auto data = gmd::importGmdAsLevel(file);
             if (!data) continue;
             auto imported = *data;
 
+            // Crash data saved before level strings were saved separately 
+            // has the level string in the level file itself
+            if (auto levelString = geode::utils::file::readString(getLevelStringPath(file))) {
+                imported->m_levelString = levelString.unwrap();
+            }
+            else if (imported->m_levelString.empty()) {
+                continue;
+            }
+
             auto num = numFromString<int>(file.stem().string());
             if (!num) continue;
 
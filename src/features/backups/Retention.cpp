@@ -0,0 +1,41 @@
+#include "Retention.hpp"
+#include <Geode/loader/Mod.hpp>
+
+RetentionPolicy RetentionPolicy::fromSettings() {
+    constexpr uintmax_t MEGABYTE = 1024 * 1024;
+    auto mod = Mod::get();
+    return RetentionPolicy {
+        .keepRecent = static_cast<size_t>(mod->template getSettingValue<int64_t>("backup-keep-recent")),
+        .keepHourly = static_cast<size_t>(mod->template getSettingValue<int64_t>("backup-keep-hourly")),
+        .keepDaily = static_cast<size_t>(mod->template getSettingValue<int64_t>("backup-keep-daily")),
+        .levelQuota = static_cast<uintmax_t>(mod->template getSettingValue<int64_t>("backup-level-quota")) * MEGABYTE,
+        .totalQuota = static_cast<uintmax_t>(mod->template getSettingValue<int64_t>("backup-total-quota")) * MEGABYTE,
+    };
+}
+
+std::vector<bool> RetentionPolicy::selectKept(std::vector<BackupMetadata> const& backups, BackupMetadata::TimePoint now) const {
+    std::vector<bool> kept(backups.size(), false);
+    std::unordered_set<int64_t> hours;
+    std::unordered_set<int64_t> days;
+    size_t recent = 0;
+    for (size_t i = 0; i < backups.size(); i += 1) {
+        auto const& meta = backups[i];
+        if (!meta.automated) {
+            kept[i] = true;
+            continue;
+        }
+        const auto age = now - meta.createTime;
+        const auto hour = std::chrono::floor<std::chrono::hours>(meta.createTime.time_since_epoch()).count();
+        const auto day = std::chrono::floor<std::chrono::days>(meta.createTime.time_since_epoch()).count();
+
+        // Since the backups are newest first, the first one seen in each 
+        // hour / day is the newest one in it
+        const bool isRecent = recent < keepRecent;
+        const bool isHourly = age < std::chrono::hours(keepHourly) && hours.insert(hour).second;
+        const bool isDaily = age < std::chrono::days(keepDaily) && days.insert(day).second;
+        recent += 1;
+
+        kept[i] = isRecent || isHourly || isDaily;
+    }
+    return kept;
+}
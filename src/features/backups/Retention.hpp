@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Backup.hpp"
+
+/**
+ * Decides which automated backups are kept around. An automated backup is 
+ * kept if it's one of the most recent ones, the newest one of its hour 
+ * within the hourly tier, or the newest one of its day within the daily 
+ * tier. On top of that, the oldest automated backups are deleted for as 
+ * long as the level's or all levels' backups take up more space than their 
+ * quota. Backups that aren't automated (including ones preserved with 
+ * `Backup::preserveAutomated`) are never deleted
+ */
+struct RetentionPolicy final {
+    size_t keepRecent = 3;
+    // How many hours back to keep one backup per hour for
+    size_t keepHourly = 24;
+    // How many days back to keep one backup per day for
+    size_t keepDaily = 7;
+    // Quotas are in bytes, with 0 meaning no limit
+    uintmax_t levelQuota = 0;
+    uintmax_t totalQuota = 0;
+
+    static RetentionPolicy fromSettings();
+
+    /**
+     * Pick which backups the tiers keep, ignoring the quotas
+     * @param backups Backups of a single level, sorted newest first
+     * @returns Whether to keep each backup
+     */
+    std::vector<bool> selectKept(std::vector<BackupMetadata> const& backups, BackupMetadata::TimePoint now) const;
+};
@@ -7,6 +7,7 @@ private:
     std::unordered_map<std::string, JSClassID> m_classes;
     std::unordered_map<int, std::function<CppFunction>> m_functions;
     std::unordered_map<JSClassID, std::function<CppClassFinalizer>> m_classFinalizers;
+    std::function<bool()> m_interruptHandler;
 
 public:
     static OpaqueData* get(JSRuntime* rt) {
@@ -40,6 +41,13 @@ public:
     void callClassFinalizer(JSClassID id, Runtime rt, Value instance) {
         return m_classFinalizers.at(id)(std::move(rt), instance);
     }
+
+    void setInterruptHandler(std::function<bool()> handler) {
+        m_interruptHandler = std::move(handler);
+    }
+    bool callInterruptHandler() {
+        return m_interruptHandler && m_interruptHandler();
+    }
 };
 
 /// Runtime
@@ -121,6 +129,21 @@ std::optional<JSClassID> Runtime::getClassID(std::string_view name) const {
     }
     return std::nullopt;
 }
+void Runtime::setInterruptHandler(std::function<bool()> handler) {
+    if (!m_rt) return;
+    this->getOpaque()->setInterruptHandler(std::move(handler));
+    JS_SetInterruptHandler(m_rt, +[](JSRuntime* rt, void*) -> int {
+        return OpaqueData::get(rt)->callInterruptHandler();
+    }, nullptr);
+}
+void Runtime::setMaxStackSize(size_t size) {
+    if (!m_rt) return;
+    JS_SetMaxStackSize(m_rt, size);
+}
+void Runtime::updateStackTop() {
+    if (!m_rt) return;
+    JS_UpdateStackTop(m_rt);
+}
 
 /// Context
 
@@ -221,6 +244,23 @@ Value Context::createNumber(double value) {
 Value Context::createString(std::string_view value) {
     return Value::own(*this, JS_NewString(m_ctx, value.data()));
 }
+Value Context::createFloat32Array(std::span<const float> data) {
+    return this->createTypedArray("Float32Array", std::as_bytes(data));
+}
+Value Context::createInt32Array(std::span<const int32_t> data) {
+    return this->createTypedArray("Int32Array", std::as_bytes(data));
+}
+Value Context::createTypedArray(std::string_view type, std::span<const std::byte> bytes) {
+    auto buffer = Value::own(*this, JS_NewArrayBufferCopy(
+        m_ctx, reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()
+    ));
+    auto ctor = this->getGlobalObject().getProperty(type);
+    if (!ctor) {
+        return this->throwTypeError("{} is not available", type);
+    }
+    auto arg = buffer.getRaw();
+    return Value::own(*this, JS_CallConstructor(m_ctx, ctor->getRaw(), 1, &arg));
+}
 Value Context::createArray() {
     return Value::own(*this, JS_NewArray(m_ctx));
 }
@@ -255,7 +295,7 @@ Value Context::createFunctionBare(std::string_view name, std::function<CppFuncti
     ));
 }
 
-Result<Module> Context::eval(std::string_view code, std::string_view filename) {
+Result<Module> Context::eval(std::string_view code, std::string_view filename, ByteVector* bytecode) {
     auto mod = Value::own(*this, JS_Eval(
         m_ctx, code.data(), code.size(), filename.data(),
         JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY
@@ -265,6 +305,34 @@ Result<Module> Context::eval(std::string_view code, std::string_view filename) {
         return Err(this->getException().toString());
     }
     auto modValue = std::move(mod).takeValue();
+    if (bytecode) {
+        size_t size = 0;
+        if (auto data = JS_WriteObject(m_ctx, &size, modValue, JS_WRITE_OBJ_BYTECODE)) {
+            *bytecode = ByteVector(data, data + size);
+            js_free(m_ctx, data);
+        }
+        // Not being able to save the bytecode doesn't stop the module from running
+        else {
+            bytecode->clear();
+            JS_FreeValue(m_ctx, JS_GetException(m_ctx));
+        }
+    }
+    return this->evalCompiled(modValue);
+}
+std::optional<Result<Module>> Context::evalBytecode(std::span<const uint8_t> bytecode) {
+    auto modValue = JS_ReadObject(m_ctx, bytecode.data(), bytecode.size(), JS_READ_OBJ_BYTECODE);
+    if (JS_IsException(modValue)) {
+        log::warn("Unable to read bytecode: {}", this->getException().toString());
+        return std::nullopt;
+    }
+    if (JS_ResolveModule(m_ctx, modValue) < 0) {
+        log::warn("Unable to resolve bytecode module: {}", this->getException().toString());
+        JS_FreeValue(m_ctx, modValue);
+        return std::nullopt;
+    }
+    return this->evalCompiled(modValue);
+}
+Result<Module> Context::evalCompiled(JSValue modValue) {
     auto def = static_cast<JSModuleDef*>(JS_VALUE_GET_PTR(modValue));
     auto eval = Value::own(*this, JS_EvalFunction(m_ctx, modValue));
     log::info("eval returned: {}", eval.getTypeName());
@@ -434,6 +502,9 @@ Runtime Value::getRuntime() const {
         return std::get<1>(m_ctxOrRt).weakCopy();
     }
 }
+JSValue Value::getRaw() const {
+    return m_value;
+}
 JSValue Value::takeValue() && {
     DEBUG_LOG("taking");
     auto value = m_value;
@@ -584,6 +655,28 @@ std::unordered_map<std::string, Value> Value::getProperties() const {
 
     return ret;
 }
+std::optional<std::span<uint8_t>> Value::getTypedArrayBytes(std::string_view type) const {
+    auto ctx = std::get_if<0>(&m_ctxOrRt);
+    if (!ctx) return std::nullopt;
+
+    auto ctor = ctx->getGlobalObject().getProperty(type);
+    if (!ctor || JS_IsInstanceOf(ctx->getRaw(), m_value, ctor->getRaw()) != 1) {
+        return std::nullopt;
+    }
+    size_t offset = 0, length = 0, bytesPerElement = 0;
+    auto buffer = Value::own(*ctx, JS_GetTypedArrayBuffer(ctx->getRaw(), m_value, &offset, &length, &bytesPerElement));
+    if (buffer.isException()) {
+        return std::nullopt;
+    }
+    // The typed array keeps its buffer alive, so the memory stays valid 
+    // after our reference to the buffer is gone
+    size_t size = 0;
+    auto data = JS_GetArrayBuffer(ctx->getRaw(), &size, buffer.getRaw());
+    if (!data) {
+        return std::nullopt;
+    }
+    return std::span(data + offset, length);
+}
 
 // Value::Iterator Value::begin() const {
 //     return Iterator(*this, 0);
@@ -666,6 +759,14 @@ Result<std::optional<Value>> Module::tick() {
     }
 }
 
+bool Module::hasPendingJobs() const {
+    auto ctx = m_ctx.getRaw();
+    if (!ctx) {
+        return false;
+    }
+    return JS_IsJobPending(JS_GetRuntime(ctx));
+}
+
 Module::Module(Module const& other)
   : m_ctx(other.m_ctx),
   m_promise(other.m_promise),
@@ -694,6 +795,14 @@ Module& Module::operator=(Module&& other) {
 
 Module::~Module() {}
 
+std::string qjs::getVersion() {
+#ifdef QJS_VERSION_MAJOR
+    return fmt::format("{}.{}.{}", QJS_VERSION_MAJOR, QJS_VERSION_MINOR, QJS_VERSION_PATCH);
+#else
+    return "unknown";
+#endif
+}
+
 // Value::Iterator::Iterator(Value value, size_t index)
 //   : m_ctx(std::get<0>(value.m_ctxOrRt)), m_value(value), m_index(index)
 // {}
@@ -4,6 +4,7 @@
 #include <string>
 #include <functional>
 #include <optional>
+#include <span>
 #include <Geode/loader/Log.hpp>
 #include <Geode/utils/general.hpp>
 
@@ -48,6 +49,18 @@ namespace qjs {
 
         Result<JSClassID> createClass(std::string_view name, std::function<CppClassFinalizer> finalizer);
         std::optional<JSClassID> getClassID(std::string_view name) const;
+
+        /**
+         * Set a function that QuickJS periodically calls while running code. 
+         * If it returns true, execution is aborted with an uncatchable error
+         */
+        void setInterruptHandler(std::function<bool()> handler);
+        void setMaxStackSize(size_t size);
+        /**
+         * Measure the stack from the current point on; needed when the 
+         * runtime is used on a different thread than it was created on
+         */
+        void updateStackTop();
     };
 
     class Context final {
@@ -100,6 +113,13 @@ namespace qjs {
         Value createInt32(int32_t value);
         Value createNumber(double value);
         Value createString(std::string_view value);
+        /**
+         * Create a typed array holding a copy of the data. Filling one with 
+         * a single copy is much faster than pushing values to an array one 
+         * by one
+         */
+        Value createFloat32Array(std::span<const float> data);
+        Value createInt32Array(std::span<const int32_t> data);
         Value createArray();
         Value createObject();
         Value createObject(JSClassID classID);
@@ -109,8 +129,40 @@ namespace qjs {
         template <class F>
         Value createFunction(std::string_view name, F&& function);
         
-        Result<Module> eval(std::string_view code, std::string_view filename);
+        /**
+         * Compile and run code as a module. If `bytecode` is provided, the 
+         * compiled module is also written into it so it can later be run 
+         * through `evalBytecode` without compiling again
+         */
+        Result<Module> eval(std::string_view code, std::string_view filename, ByteVector* bytecode = nullptr);
+        /**
+         * Run a module from bytecode produced by `eval`. Returns nullopt if 
+         * the bytecode can't be loaded, for example because it was written 
+         * by a different version of QuickJS
+         */
+        std::optional<Result<Module>> evalBytecode(std::span<const uint8_t> bytecode);
+
+    private:
+        Result<Module> evalCompiled(JSValue compiled);
+        Value createTypedArray(std::string_view type, std::span<const std::byte> bytes);
+    };
+
+    /**
+     * A view into the memory of a JS typed array, for passing large amounts 
+     * of data to C++ without converting every element. Writes go straight 
+     * to the JS array. Only valid during the call it was passed to
+     */
+    template <class T>
+    struct TypedArray final {
+        std::span<T> data;
     };
+    using Float32Array = TypedArray<float>;
+    using Int32Array = TypedArray<int32_t>;
+
+    /**
+     * The version of QuickJS in use, or "unknown" if it doesn't say
+     */
+    std::string getVersion();
 
     class Value final {
     public:
@@ -154,6 +206,7 @@ namespace qjs {
         bool isClass(JSClassID id) const;
 
         Runtime getRuntime() const;
+        JSValue getRaw() const;
         JSValue takeValue() &&;
 
         bool isException() const;
@@ -177,6 +230,11 @@ namespace qjs {
         std::optional<Value> getProperty(std::string_view prop) const;
         std::vector<std::string> getPropertyNames() const;
         std::unordered_map<std::string, Value> getProperties() const;
+        /**
+         * Get the memory of this value if it's a typed array of the given 
+         * type (like "Float32Array")
+         */
+        std::optional<std::span<uint8_t>> getTypedArrayBytes(std::string_view type) const;
 
         // Iterator begin() const;
         // Iterator end() const;
@@ -215,6 +273,12 @@ namespace qjs {
         Module& operator=(Module&&);
 
         Result<std::optional<Value>> tick();
+        /**
+         * Whether the runtime has jobs queued up that the next `tick()` would 
+         * execute. A module may still be unfinished while this is false if 
+         * it's waiting on something else, like user input
+         */
+        bool hasPendingJobs() const;
 
         ~Module();
     };
@@ -374,6 +438,7 @@ namespace qjs {
                     return Err("Expected array, got {}", arg.getTypeName());
                 }
                 std::vector<Ty> result;
+                result.reserve(arg.getLength().value_or(0));
                 size_t ix = 0;
                 for (auto js : arg.getArrayItems()) {
                     if (auto cpp = parseJsType<Ty>(ctx, js)) {
@@ -396,6 +461,36 @@ namespace qjs {
         };
         static_assert(IsValidJsTypeToCpp<std::vector<Value>>);
 
+        template <class Ty>
+        inline constexpr std::string_view TYPED_ARRAY_NAME = "";
+        template <>
+        inline constexpr std::string_view TYPED_ARRAY_NAME<float> = "Float32Array";
+        template <>
+        inline constexpr std::string_view TYPED_ARRAY_NAME<int32_t> = "Int32Array";
+
+        template <class Ty>
+        struct JsTypeToCpp<TypedArray<Ty>> {
+            static Result<TypedArray<Ty>> from(Context ctx, Value arg) {
+                auto bytes = arg.getTypedArrayBytes(TYPED_ARRAY_NAME<Ty>);
+                if (!bytes) {
+                    return Err("Expected {}, got {}", TYPED_ARRAY_NAME<Ty>, arg.getTypeName());
+                }
+                return Ok(TypedArray<Ty> {
+                    .data = std::span(reinterpret_cast<Ty*>(bytes->data()), bytes->size() / sizeof(Ty)),
+                });
+            }
+            static Value to(Context ctx, TypedArray<Ty> value) {
+                if constexpr (std::is_same_v<Ty, float>) {
+                    return ctx.createFloat32Array(value.data);
+                }
+                else {
+                    return ctx.createInt32Array(value.data);
+                }
+            }
+        };
+        static_assert(IsValidJsTypeToCpp<Float32Array>);
+        static_assert(IsValidJsTypeToCpp<Int32Array>);
+
         template <class... Tys>
         struct JsTypeToCpp<std::tuple<Tys...>> {
             static Result<std::tuple<Tys...>> from(Context ctx, Value arg) {
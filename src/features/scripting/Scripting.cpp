@@ -1,9 +1,15 @@
 #include "Scripting.hpp"
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/file.hpp>
+#include <Geode/utils/ranges.hpp>
 #include <Geode/binding/EditorUI.hpp>
 #include <Geode/binding/GameObject.hpp>
 #include <Geode/modify/LevelEditorLayer.hpp>
+#include <utils/LevelStats.hpp>
+#include <utils/GroupIndex.hpp>
+#include <utils/Editor.hpp>
+#include <utils/Hash.hpp>
+#include <unordered_set>
 
 using namespace geode::prelude;
 
@@ -253,38 +259,166 @@ void JsScript::log(Log::Level level, std::string_view message) {
     }
 }
 
+static constexpr std::string_view BYTECODE_CACHE_MAGIC = "BEQBC2 ";
+
+// How many groups an object can be in
+static constexpr int32_t GROUPS_PER_OBJECT = 10;
+
+// Script threads may get less stack than the main thread (only 512KB on 
+// macOS), so keep QuickJS's own overflow check well under that
+static constexpr size_t SCRIPT_MAX_STACK_SIZE = 256 * 1024;
+
+struct JsScript::Environment final {
+    qjs::Runtime runtime = qjs::Runtime::null();
+    qjs::Context ctx = qjs::Context::null();
+    // The script running in this environment, for bindings that report back to it
+    JsScript* script = nullptr;
+};
+
+JsScript::~JsScript() {
+    this->cancel();
+}
+
 bool JsScript::run() {
-    // Note: script can not be running multiple times at once!
-    // ^ This is currently not being checked in any way
     if (!this->canRun()) {
         return false;
     }
+    // Running a script again restarts it
+    this->cancel();
 
     // First make sure all previous context is destroyed
     m_lastRunLogs.clear();
     m_finished = false;
-    m_runtime = qjs::Runtime::null();
-    m_ctx = qjs::Context::null();
     m_module = qjs::Module::null();
+    m_env = nullptr;
+    m_runTime = {};
+    m_progress = std::nullopt;
 
-    // Start up new runtime
-    m_runtime = qjs::Runtime::create();
-    m_ctx = qjs::Context::create(m_runtime);
+    auto const setupStart = std::chrono::steady_clock::now();
+    auto env = ScriptManager::get()->takeEnvironment();
+    if (!env) {
+        m_finished = true;
+        this->log(Log::Level::Error, env.unwrapErr());
+        return false;
+    }
+    log::debug(
+        "Got an environment for script {} in {:.3f} ms", m_title,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count()
+    );
+    m_env = env.unwrap();
+    m_env->script = this;
+    m_mainThreadID = std::this_thread::get_id();
+
+    m_threadDone = false;
+    m_scriptsTurn = false;
+    m_cancelRequested = false;
+    m_thread = std::thread([this] {
+        this->runOnThread();
+    });
+    ScriptManager::get()->schedule(shared_from_this());
+    return true;
+}
+void JsScript::runOnThread() {
+    {
+        std::unique_lock lock(m_turnMutex);
+        this->waitForTurn(lock);
+    }
+    if (!m_cancelRequested && this->setup()) {
+        while (!m_finished) {
+            this->tick();
+            // If the script is waiting on something other than its own jobs, 
+            // let the game go on until the next frame
+            if (!m_finished && !m_module.hasPendingJobs()) {
+                this->yieldTurn();
+            }
+            if (m_cancelRequested) {
+                break;
+            }
+        }
+    }
+    m_finished = true;
+    if (m_cancelRequested) {
+        this->log(Log::Level::Status, "Script was cancelled");
+    }
 
-    auto gameObjectClassID = m_runtime.createClass(
+    // Hand control back to the main thread for good
+    std::unique_lock lock(m_turnMutex);
+    m_threadDone = true;
+    m_scriptsTurn = false;
+    m_turnCV.notify_all();
+}
+void JsScript::waitForTurn(std::unique_lock<std::mutex>& lock) {
+    m_turnCV.wait(lock, [this] { return m_scriptsTurn; });
+}
+void JsScript::yieldTurn() {
+    std::unique_lock lock(m_turnMutex);
+    m_scriptsTurn = false;
+    m_turnCV.notify_all();
+    this->waitForTurn(lock);
+}
+void JsScript::callOnMainThread(std::function<void()> const& call) {
+    if (std::this_thread::get_id() == m_mainThreadID) {
+        return call();
+    }
+    std::unique_lock lock(m_turnMutex);
+    m_mainThreadCall = &call;
+    m_turnCV.notify_all();
+    m_turnCV.wait(lock, [this] { return m_mainThreadCall == nullptr; });
+}
+void JsScript::resume(std::chrono::steady_clock::duration slice) {
+    auto const start = std::chrono::steady_clock::now();
+    std::unique_lock lock(m_turnMutex);
+    if (m_threadDone) {
+        return;
+    }
+    m_sliceDeadline = start + slice;
+    m_scriptsTurn = true;
+    m_turnCV.notify_all();
+    while (true) {
+        m_turnCV.wait(lock, [this] { return !m_scriptsTurn || m_mainThreadCall; });
+        if (!m_mainThreadCall) {
+            break;
+        }
+        // The script thread is blocked until this is done, so the lock 
+        // doesn't need to be held meanwhile
+        lock.unlock();
+        (*m_mainThreadCall)();
+        lock.lock();
+        m_mainThreadCall = nullptr;
+        m_turnCV.notify_all();
+    }
+    m_runTime += std::chrono::steady_clock::now() - start;
+}
+
+Result<std::shared_ptr<JsScript::Environment>> JsScript::createEnvironment() {
+    auto env = std::make_shared<Environment>();
+    env->runtime = qjs::Runtime::create();
+    env->runtime.setMaxStackSize(SCRIPT_MAX_STACK_SIZE);
+    env->ctx = qjs::Context::create(env->runtime);
+
+    auto gameObjectClassID = env->runtime.createClass(
         "GameObject",
         +[](qjs::Runtime, qjs::Value const& value) {
-            CC_SAFE_RELEASE(value.getOpaque<GameObject>());
+            auto obj = value.getOpaque<GameObject>();
+            // Finalizers mostly run on the script thread. Objects that are 
+            // still in the editor can be released right away, but freeing one 
+            // may free GL resources like a particle system's buffers, which 
+            // has to happen on the main thread
+            if (obj && obj->retainCount() == 1) {
+                Loader::get()->queueInMainThread([obj] {
+                    obj->release();
+                });
+            }
+            else {
+                CC_SAFE_RELEASE(obj);
+            }
         }
     );
     if (!gameObjectClassID) {
-        this->log(Log::Level::Error, fmt::format(
-            "Unable to setup GameObject class: {}",
-            gameObjectClassID.unwrapErr()
-        ));
+        return Err("Unable to setup GameObject class: {}", gameObjectClassID.unwrapErr());
     }
 
-    auto gameObjectClassProto = m_ctx.createObject();
+    auto gameObjectClassProto = env->ctx.createObject();
     gameObjectClassProto.setProperty(
         "id", 
         [](qjs::Context, GameObject* self) {
@@ -339,11 +473,11 @@ bool JsScript::run() {
             return rotation;
         }
     );
-    m_ctx.setClassProto(*gameObjectClassID, gameObjectClassProto);
+    env->ctx.setClassProto(*gameObjectClassID, gameObjectClassProto);
 
-    auto global = m_ctx.getGlobalObject();
+    auto global = env->ctx.getGlobalObject();
 
-    global.setProperty("print", m_ctx.createFunctionBare("", [this](qjs::Context ctx, auto, std::vector<qjs::Value> const& args) {
+    global.setProperty("print", env->ctx.createFunctionBare("", [env = env.get()](qjs::Context ctx, auto, std::vector<qjs::Value> const& args) {
         std::string log = "";
         for (size_t i = 0; i < args.size(); i += 1) {
             if (i > 0) {
@@ -351,10 +485,10 @@ bool JsScript::run() {
             }
             log += args.at(i).toString();
         }
-        this->log(Log::Level::Info, log);
+        env->script->log(Log::Level::Info, log);
         return ctx.createUndefined();
     }));
-    global.setProperty("input", m_ctx.createFunction(
+    global.setProperty("input", env->ctx.createFunction(
         "input",
         [](qjs::Context ctx, qjs::Value, std::unordered_map<std::string, ScriptInput> const& inputs) {
             auto promise = ctx.createPromise();
@@ -380,14 +514,19 @@ bool JsScript::run() {
         }
     ));
 
-    auto editor = m_ctx.createObject();
-    editor.setProperty("createObject", m_ctx.createFunction(
+    auto editor = env->ctx.createObject();
+    editor.setProperty("createObject", env->ctx.createFunction(
         "<Editor>.createObject",
-        [](qjs::Context, qjs::Value, int32_t objID) {
-            return EditorUI::get()->createObject(objID, ccp(0, 0));
+        [env = env.get()](qjs::Context, qjs::Value, int32_t objID) {
+            // Some objects like particles set up GL buffers when created
+            GameObject* obj = nullptr;
+            env->script->callOnMainThread([&] {
+                obj = EditorUI::get()->createObject(objID, ccp(0, 0));
+            });
+            return obj;
         }
     ));
-    editor.setProperty("moveObjectsBy", m_ctx.createFunction(
+    editor.setProperty("moveObjectsBy", env->ctx.createFunction(
         "<Editor>.moveObjectsBy",
         [](qjs::Context, qjs::Value, std::vector<GameObject*> const& objs, CCPoint const& by) {
             for (auto obj : objs) {
@@ -396,13 +535,149 @@ bool JsScript::run() {
             return nullptr;
         }
     ));
-    editor.setProperty("getSelectedObjects", m_ctx.createFunction(
+
+    // Bulk versions of the object properties, so scripts working on lots of 
+    // objects can read everything at once, compute in JS, and commit the 
+    // results in one call instead of going through each object's properties
+    editor.setProperty("getPositions", env->ctx.createFunction(
+        "<Editor>.getPositions",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs) {
+            std::vector<float> positions;
+            positions.reserve(objs.size() * 2);
+            for (auto obj : objs) {
+                positions.push_back(obj->getPositionX());
+                positions.push_back(obj->getPositionY());
+            }
+            return ctx.createFloat32Array(positions);
+        }
+    ));
+    editor.setProperty("setPositions", env->ctx.createFunction(
+        "<Editor>.setPositions",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs, qjs::Float32Array positions) {
+            if (positions.data.size() != objs.size() * 2) {
+                return ctx.throwTypeError("Expected {} values for positions, got {}", objs.size() * 2, positions.data.size());
+            }
+            for (size_t i = 0; i < objs.size(); i += 1) {
+                auto obj = objs[i];
+                auto pos = ccp(positions.data[i * 2], positions.data[i * 2 + 1]);
+                EditorUI::get()->moveObject(obj, pos - obj->getPosition());
+            }
+            return ctx.createUndefined();
+        }
+    ));
+    editor.setProperty("getRotations", env->ctx.createFunction(
+        "<Editor>.getRotations",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs) {
+            std::vector<float> rotations;
+            rotations.reserve(objs.size());
+            for (auto obj : objs) {
+                rotations.push_back(obj->getRotation());
+            }
+            return ctx.createFloat32Array(rotations);
+        }
+    ));
+    editor.setProperty("setRotations", env->ctx.createFunction(
+        "<Editor>.setRotations",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs, qjs::Float32Array rotations) {
+            if (rotations.data.size() != objs.size()) {
+                return ctx.throwTypeError("Expected {} values for rotations, got {}", objs.size(), rotations.data.size());
+            }
+            for (size_t i = 0; i < objs.size(); i += 1) {
+                objs[i]->setRotation(rotations.data[i]);
+            }
+            return ctx.createUndefined();
+        }
+    ));
+    editor.setProperty("getScales", env->ctx.createFunction(
+        "<Editor>.getScales",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs) {
+            std::vector<float> scales;
+            scales.reserve(objs.size() * 2);
+            for (auto obj : objs) {
+                scales.push_back(obj->getScaleX());
+                scales.push_back(obj->getScaleY());
+            }
+            return ctx.createFloat32Array(scales);
+        }
+    ));
+    editor.setProperty("setScales", env->ctx.createFunction(
+        "<Editor>.setScales",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs, qjs::Float32Array scales) {
+            if (scales.data.size() != objs.size() * 2) {
+                return ctx.throwTypeError("Expected {} values for scales, got {}", objs.size() * 2, scales.data.size());
+            }
+            for (size_t i = 0; i < objs.size(); i += 1) {
+                objs[i]->setScaleX(scales.data[i * 2]);
+                objs[i]->setScaleY(scales.data[i * 2 + 1]);
+            }
+            return ctx.createUndefined();
+        }
+    ));
+    // Groups are passed as GROUPS_PER_OBJECT slots per object, with 0 
+    // marking an empty slot
+    editor.setProperty("GROUPS_PER_OBJECT", env->ctx.createInt32(GROUPS_PER_OBJECT), true);
+    editor.setProperty("getGroups", env->ctx.createFunction(
+        "<Editor>.getGroups",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs) {
+            std::vector<int32_t> groups(objs.size() * GROUPS_PER_OBJECT, 0);
+            for (size_t i = 0; i < objs.size(); i += 1) {
+                auto obj = objs[i];
+                for (short g = 0; g < obj->m_groupCount && g < GROUPS_PER_OBJECT; g += 1) {
+                    groups[i * GROUPS_PER_OBJECT + g] = obj->m_groups->at(g);
+                }
+            }
+            return ctx.createInt32Array(groups);
+        }
+    ));
+    editor.setProperty("setGroups", env->ctx.createFunction(
+        "<Editor>.setGroups",
+        [](qjs::Context ctx, qjs::Value, std::vector<GameObject*> const& objs, qjs::Int32Array groups) {
+            if (groups.data.size() != objs.size() * GROUPS_PER_OBJECT) {
+                return ctx.throwTypeError(
+                    "Expected {} values for groups, got {}",
+                    objs.size() * GROUPS_PER_OBJECT, groups.data.size()
+                );
+            }
+            // Check everything first so a bad ID doesn't leave the level half-changed
+            for (auto group : groups.data) {
+                if (group < 0 || group > be::GroupIndex::MAX_GROUP_ID) {
+                    return ctx.throwTypeError("Invalid group ID {}", group);
+                }
+            }
+            // Both the object's own groups and the editor's group lists have 
+            // to be updated, the same way SetGroupIDLayer does it
+            auto lel = LevelEditorLayer::get();
+            for (size_t i = 0; i < objs.size(); i += 1) {
+                auto obj = objs[i];
+                auto wanted = groups.data.subspan(i * GROUPS_PER_OBJECT, GROUPS_PER_OBJECT);
+                std::vector<int> current;
+                for (short g = 0; g < obj->m_groupCount; g += 1) {
+                    current.push_back(obj->m_groups->at(g));
+                }
+                for (auto group : current) {
+                    if (!ranges::contains(wanted, group)) {
+                        lel->removeFromGroup(obj, group);
+                        obj->removeFromGroup(group);
+                    }
+                }
+                for (auto group : wanted) {
+                    if (group != 0 && !ranges::contains(current, group)) {
+                        obj->addToGroup(group);
+                        lel->addToGroup(obj, group, false);
+                        current.push_back(group);
+                    }
+                }
+            }
+            return ctx.createUndefined();
+        }
+    ));
+    editor.setProperty("getSelectedObjects", env->ctx.createFunction(
         "<Editor>.getSelectedObjects",
         [](qjs::Context, qjs::Value) {
             return ccArrayToVector<GameObject*>(EditorUI::get()->getSelectedObjects());
         }
     ));
-    editor.setProperty("getViewCenter", m_ctx.createFunction(
+    editor.setProperty("getViewCenter", env->ctx.createFunction(
         "<Editor>.getViewCenter",
         [](qjs::Context, qjs::Value) {
             return LevelEditorLayer::get()->m_objectLayer->convertToNodeSpace(
@@ -410,16 +685,159 @@ bool JsScript::run() {
             );
         }
     ));
+    editor.setProperty("getLevelStats", env->ctx.createFunction(
+        "<Editor>.getLevelStats",
+        [](qjs::Context ctx, qjs::Value) {
+            auto stats = be::LevelStats::get();
+            if (!stats) {
+                return ctx.createNull();
+            }
+            auto countsToJs = [&](be::LevelStats::Counts const& counts) {
+                auto obj = ctx.createObject();
+                for (auto const& [key, count] : counts) {
+                    obj.setProperty(numToString(key), ctx.createInt32(static_cast<int32_t>(count)));
+                }
+                return obj;
+            };
+            auto ret = ctx.createObject();
+            ret.setProperty("objectCount", ctx.createInt32(static_cast<int32_t>(stats->getObjectCount())));
+            ret.setProperty("ldmCount", ctx.createInt32(static_cast<int32_t>(stats->getHighDetailCount())));
+            ret.setProperty("triggerCount", ctx.createInt32(static_cast<int32_t>(stats->getTriggerCount())));
+            ret.setProperty("objectsByID", countsToJs(stats->getObjectsByID()));
+            ret.setProperty("objectsByLayer", countsToJs(stats->getObjectsByLayer()));
+            ret.setProperty("objectsByColor", countsToJs(stats->getObjectsByColor()));
+            ret.setProperty("objectsByGroup", countsToJs(stats->getObjectsByGroup()));
+            ret.setProperty("triggersByID", countsToJs(stats->getTriggersByID()));
+            return ret;
+        }
+    ));
+    editor.setProperty("setProgress", env->ctx.createFunction(
+        "<Editor>.setProgress",
+        [env = env.get()](qjs::Context ctx, qjs::Value, double progress) {
+            env->script->m_progress = std::clamp(static_cast<float>(progress), 0.f, 1.f);
+            return ctx.createUndefined();
+        }
+    ));
     global.setProperty("editor", editor);
 
-    auto value = m_ctx.eval(m_data, m_path.filename().string());
+
+    return Ok(env);
+}
+bool JsScript::setup() {
+    // Environments are created ahead of time on the main thread, so point 
+    // QuickJS's stack overflow check at this thread's stack instead
+    m_env->runtime.updateStackTop();
+    // QuickJS can't suspend running code on its own, so when the slice runs 
+    // out the interrupt handler just blocks this thread until the next one. 
+    // Only cancelling actually interrupts the script. The main thread must 
+    // never block on itself, so it never yields
+    m_env->runtime.setInterruptHandler([this, scriptThread = std::this_thread::get_id()] {
+        if (
+            !m_cancelRequested && std::this_thread::get_id() == scriptThread &&
+            std::chrono::steady_clock::now() >= m_sliceDeadline
+        ) {
+            this->yieldTurn();
+        }
+        return m_cancelRequested;
+    });
+
+    auto value = this->loadModule();
     if (!value) {
-        this->log(Log::Level::Error, value.unwrapErr());
+        m_finished = true;
+        if (!m_cancelRequested) {
+            this->log(Log::Level::Error, value.unwrapErr());
+        }
         return false;
     }
     m_module = *value;
     return true;
 }
+std::filesystem::path JsScript::getBytecodeCachePath() const {
+    return ScriptManager::getBytecodeCacheDir() / fmt::format(
+        "{}.qbc", be::hashToString(be::hash64(m_path.string()))
+    );
+}
+static std::string_view asString(std::span<const uint8_t> data) {
+    return std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+}
+// The header is the key followed by the length and hash of the bytecode. 
+// QuickJS doesn't validate bytecode, so a cache file that was cut short or 
+// corrupted has to be caught before it gets loaded
+static std::optional<std::span<const uint8_t>> getCachedBytecode(ByteVector const& data, std::string_view key) {
+    auto const headerEnd = std::find(data.begin(), data.end(), '\n');
+    if (headerEnd == data.end()) {
+        return std::nullopt;
+    }
+    auto const header = asString(std::span(data.begin(), headerEnd));
+    if (!header.starts_with(key)) {
+        return std::nullopt;
+    }
+    auto const rest = header.substr(key.size());
+    auto const space = rest.find(' ');
+    if (space == std::string_view::npos) {
+        return std::nullopt;
+    }
+    auto const bytecode = std::span(headerEnd + 1, data.end());
+    auto const length = numFromString<size_t>(rest.substr(0, space));
+    if (!length || *length != bytecode.size()) {
+        return std::nullopt;
+    }
+    if (rest.substr(space + 1) != be::hashToString(be::hash64(asString(bytecode)))) {
+        return std::nullopt;
+    }
+    return bytecode;
+}
+
+Result<qjs::Module> JsScript::loadModule() {
+    // The bytecode format may change between QuickJS versions, and the 
+    // bindings between BE versions, so both are part of the key
+    be::Hasher hasher;
+    hasher.update(m_data);
+    hasher.update(qjs::getVersion());
+    hasher.update(Mod::get()->getVersion().toVString());
+    auto key = fmt::format("{}{} ", BYTECODE_CACHE_MAGIC, be::hashToString(hasher.digest()));
+
+    auto cachePath = this->getBytecodeCachePath();
+    if (auto cached = file::readBinary(cachePath)) {
+        if (auto bytecode = getCachedBytecode(cached.unwrap(), key)) {
+            if (auto module = m_env->ctx.evalBytecode(*bytecode)) {
+                return *module;
+            }
+        }
+    }
+
+    // Cache is missing or out of date, so compile from scratch and replace it
+    ByteVector bytecode;
+    auto module = m_env->ctx.eval(m_data, m_path.filename().string(), &bytecode);
+    if (!bytecode.empty()) {
+        auto header = fmt::format(
+            "{}{} {}\n", key, bytecode.size(), be::hashToString(be::hash64(asString(bytecode)))
+        );
+        auto data = ByteVector(header.begin(), header.end());
+        data.insert(data.end(), bytecode.begin(), bytecode.end());
+
+        // Written under a temporary name first, so a file cut short by the 
+        // game closing never replaces a working cache
+        auto tempPath = cachePath;
+        tempPath += ".tmp";
+        auto written = file::createDirectoryAll(cachePath.parent_path());
+        if (written) {
+            written = file::writeBinary(tempPath, data);
+        }
+        if (written) {
+            std::error_code ec;
+            std::filesystem::rename(tempPath, cachePath, ec);
+            if (ec) {
+                written = Err("{} (code {})", ec.message(), ec.value());
+            }
+        }
+        if (!written) {
+            log::warn("Unable to cache bytecode for script {}: {}", m_title, written.unwrapErr());
+        }
+    }
+    return module;
+}
+
 bool JsScript::tick() {
     if (m_finished) {
         return true;
@@ -427,7 +845,10 @@ bool JsScript::tick() {
     auto res = m_module.tick();
     if (!res) {
         m_finished = true;
-        this->log(Log::Level::Error, res.unwrapErr());
+        // Cancelling shows up as an "interrupted" error
+        if (!m_cancelRequested) {
+            this->log(Log::Level::Error, res.unwrapErr());
+        }
         return false;
     }
     auto value = res.unwrap();
@@ -437,6 +858,29 @@ bool JsScript::tick() {
     }
     return true;
 }
+void JsScript::cancel() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    std::unique_lock lock(m_turnMutex);
+    m_cancelRequested = true;
+    while (!m_threadDone) {
+        lock.unlock();
+        this->resume(std::chrono::steady_clock::duration::zero());
+        lock.lock();
+    }
+    lock.unlock();
+    m_thread.join();
+}
+bool JsScript::isRunning() const {
+    return !m_finished;
+}
+std::chrono::steady_clock::duration JsScript::getRunTime() const {
+    return m_runTime;
+}
+std::optional<float> JsScript::getProgress() const {
+    return m_progress;
+}
 
 JsScriptLoggedEvent::JsScriptLoggedEvent(std::shared_ptr<JsScript> script) : script(script) {}
 
@@ -458,6 +902,49 @@ std::vector<std::shared_ptr<JsScript>> ScriptManager::getScripts() const {
     return m_scripts;
 }
 
+std::filesystem::path ScriptManager::getBytecodeCacheDir() {
+    return Mod::get()->getSaveDir() / "script-cache";
+}
+
+// Timed so the debug logs show what setting up an environment costs, and 
+// with "Got an environment" from `JsScript::run`, how much of that the warm 
+// pool takes off of running a script
+static Result<std::shared_ptr<JsScript::Environment>> createTimedEnvironment(std::string_view kind) {
+    auto const start = std::chrono::steady_clock::now();
+    auto env = JsScript::createEnvironment();
+    log::debug(
+        "Set up {} script environment in {:.3f} ms", kind,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+    );
+    return env;
+}
+
+void ScriptManager::prewarm() {
+    m_refillQueued = false;
+    while (m_warmEnvironments.size() < WARM_ENVIRONMENTS) {
+        auto env = createTimedEnvironment("warm");
+        if (!env) {
+            log::error("Unable to set up script environment: {}", env.unwrapErr());
+            break;
+        }
+        m_warmEnvironments.push_back(env.unwrap());
+    }
+}
+Result<std::shared_ptr<JsScript::Environment>> ScriptManager::takeEnvironment() {
+    if (m_warmEnvironments.empty()) {
+        return createTimedEnvironment("cold");
+    }
+    auto env = std::move(m_warmEnvironments.back());
+    m_warmEnvironments.pop_back();
+    if (!m_refillQueued) {
+        m_refillQueued = true;
+        Loader::get()->queueInMainThread([] {
+            ScriptManager::get()->prewarm();
+        });
+    }
+    return Ok(env);
+}
+
 void ScriptManager::reloadScripts() {
     m_scripts.clear();
     for (auto& dir : {
@@ -473,14 +960,103 @@ void ScriptManager::reloadScripts() {
             }
         }
     }
+
+    // Clear out cached bytecode of scripts that no longer exist
+    std::unordered_set<std::string> cached;
+    for (auto& script : m_scripts) {
+        cached.insert(script->getBytecodeCachePath().filename().string());
+    }
+    if (auto files = file::readDirectory(ScriptManager::getBytecodeCacheDir())) {
+        for (auto& file : files.unwrap()) {
+            if (!cached.contains(file.filename().string())) {
+                std::error_code ec;
+                std::filesystem::remove(file, ec);
+            }
+        }
+    }
 }
 
-bool ScriptManager::tickAll() {
-    bool success = true;
-    for (auto script : m_scripts) {
-        success &= !script->tick();
+void ScriptManager::schedule(std::shared_ptr<JsScript> script) {
+    if (
+        ranges::contains(m_active, script) ||
+        std::find(m_queued.begin(), m_queued.end(), script) != m_queued.end()
+    ) {
+        return;
+    }
+    m_queued.push_back(script);
+    this->promoteQueued();
+    this->updateTicking();
+}
+void ScriptManager::cancelAll() {
+    for (auto& script : m_active) {
+        script->cancel();
+    }
+    for (auto& script : m_queued) {
+        script->cancel();
     }
-    return success;
+    m_active.clear();
+    m_queued.clear();
+    m_nextActive = 0;
+    this->updateTicking();
+}
+
+size_t ScriptManager::getActiveCount() const {
+    return m_active.size();
+}
+size_t ScriptManager::getQueuedCount() const {
+    return m_queued.size();
+}
+
+void ScriptManager::promoteQueued() {
+    while (m_active.size() < MAX_ACTIVE_SCRIPTS && !m_queued.empty()) {
+        auto script = std::move(m_queued.front());
+        m_queued.pop_front();
+        // Scripts may have been cancelled or restarted while waiting
+        if (script->isRunning()) {
+            m_active.push_back(std::move(script));
+        }
+    }
+}
+
+std::chrono::steady_clock::duration ScriptManager::getFrameBudget() {
+    return std::chrono::milliseconds(Mod::get()->template getSettingValue<int64_t>("script-frame-budget"));
+}
+
+void ScriptManager::tick() {
+    auto const start = std::chrono::steady_clock::now();
+    auto const budget = ScriptManager::getFrameBudget();
+
+    // Take a copy since finished scripts are removed from the list
+    auto order = m_active;
+    if (!order.empty()) {
+        std::rotate(order.begin(), order.begin() + m_nextActive % order.size(), order.end());
+    }
+    for (size_t i = 0; i < order.size(); i += 1) {
+        auto left = budget - (std::chrono::steady_clock::now() - start);
+        if (left <= std::chrono::steady_clock::duration::zero()) {
+            break;
+        }
+        // Split what's left evenly between the scripts that haven't gone yet, 
+        // so time unused by waiting scripts goes to the busy ones
+        auto& script = order[i];
+        script->resume(left / static_cast<int64_t>(order.size() - i));
+        if (!script->isRunning()) {
+            std::erase(m_active, script);
+        }
+    }
+    this->promoteQueued();
+    m_nextActive += 1;
+    
+    this->updateTicking();
+}
+
+$execute {
+    // A paused script would otherwise stay blocked until the next editor is 
+    // opened, holding on to the objects of this one
+    new EventListener<EventFilter<EditorExitEvent>>(+[](EditorExitEvent*) {
+        ScriptManager::get()->cancelAll();
+        return ListenerResult::Propagate;
+    });
 }
 
 class $modify(TickEditorLayer, LevelEditorLayer) {
@@ -488,13 +1064,30 @@ class $modify(TickEditorLayer, LevelEditorLayer) {
         if (!LevelEditorLayer::init(level, p1))
             return false;
         
-        // todo: this should be optimized to only run when scripts are running
-        this->schedule(schedule_selector(TickEditorLayer::onTick));
+        // Scripts left over from a previous editor refer to its objects
+        ScriptManager::get()->cancelAll();
         
         return true;
     }
 
     void onTick(float) {
-        ScriptManager::get()->tickAll();
+        ScriptManager::get()->tick();
     }
 };
+
+void ScriptManager::updateTicking() {
+    // Only tick while there are scripts running so an idle editor costs nothing
+    bool shouldTick = !m_active.empty() || !m_queued.empty();
+    auto lel = LevelEditorLayer::get();
+    if (!lel) {
+        m_ticking = false;
+        return;
+    }
+    if (shouldTick && !m_ticking) {
+        lel->schedule(schedule_selector(TickEditorLayer::onTick));
+    }
+    else if (!shouldTick && m_ticking) {
+        lel->unschedule(schedule_selector(TickEditorLayer::onTick));
+    }
+    m_ticking = shouldTick;
+}
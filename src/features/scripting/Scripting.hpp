@@ -1,6 +1,11 @@
 #pragma once
 
 #include <filesystem>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <Geode/binding/GameObject.hpp>
 #include <Geode/utils/VersionInfo.hpp>
 #include <Geode/utils/cocos.hpp>
@@ -11,6 +16,13 @@ using namespace geode::prelude;
 
 class JsScript final : public std::enable_shared_from_this<JsScript> {
 public:
+    /**
+     * A runtime and context with all of the bindings installed, ready for a 
+     * script to run in. A context can't be cleaned of whatever a script 
+     * leaves behind in it, so each environment is only used for one run
+     */
+    struct Environment;
+
     struct Log final {
         enum class Level {
             Status,
@@ -32,10 +44,27 @@ private:
     bool m_queuedLogEvent = false;
     bool m_runnable = true;
     bool m_finished = true;
-    qjs::Runtime m_runtime = qjs::Runtime::null();
-    qjs::Context m_ctx = qjs::Context::null();
+    std::shared_ptr<Environment> m_env;
     qjs::Module m_module = qjs::Module::null();
 
+    // Scripts run on their own thread so that they can be paused in the 
+    // middle of synchronous code and resumed on the next frame. The thread 
+    // only ever runs while the main thread is waiting for it in `resume()`, 
+    // so bindings can touch the game directly from it. The few that need the 
+    // main thread itself (like for GL calls) go through `callOnMainThread`
+    std::thread m_thread;
+    std::thread::id m_mainThreadID;
+    std::mutex m_turnMutex;
+    std::condition_variable m_turnCV;
+    bool m_scriptsTurn = false;
+    bool m_threadDone = true;
+    bool m_cancelRequested = false;
+    // A call the script thread is waiting for the main thread to run
+    std::function<void()> const* m_mainThreadCall = nullptr;
+    std::chrono::steady_clock::time_point m_sliceDeadline;
+    std::chrono::steady_clock::duration m_runTime {};
+    std::optional<float> m_progress;
+
     void log(Log::Level level, std::string_view message);
 
     template <class... Args>
@@ -43,6 +72,19 @@ private:
         this->log(level, fmt::format(fmt, std::forward<Args>(args)...));
     }
 
+    bool setup();
+    Result<qjs::Module> loadModule();
+    bool tick();
+    void runOnThread();
+    void waitForTurn(std::unique_lock<std::mutex>& lock);
+    void yieldTurn();
+    /**
+     * Run a call on the main thread, blocking the script thread until it's 
+     * done. Each call costs two thread switches, so only use this for what 
+     * really can't run on the script thread. The call must not run any JS
+     */
+    void callOnMainThread(std::function<void()> const& call);
+
 public:
     static std::shared_ptr<JsScript> create(std::filesystem::path const& path);
 
@@ -54,8 +96,42 @@ public:
     Log::Level getLastRunSeverity() const;
     bool canRun() const;
 
+    ~JsScript();
+
+    static Result<std::shared_ptr<Environment>> createEnvironment();
+
+    /**
+     * Start running the script. The script only makes progress while 
+     * `resume()` is called, which `ScriptManager` does every frame
+     */
     bool run();
-    bool tick();
+    /**
+     * Let the script run until it finishes, runs out of pending jobs, or 
+     * the slice runs out. Blocks the calling thread meanwhile, except for 
+     * running the calls the script hands to the main thread. Must be called 
+     * from the main thread
+     */
+    void resume(std::chrono::steady_clock::duration slice);
+    /**
+     * Stop the script if it's still running
+     */
+    void cancel();
+
+    bool isRunning() const;
+    /**
+     * How long the script has been running for in total, not counting 
+     * the time it spent paused
+     */
+    std::chrono::steady_clock::duration getRunTime() const;
+    /**
+     * The progress the script has reported through `editor.setProgress`, 
+     * if any
+     */
+    std::optional<float> getProgress() const;
+    /**
+     * Where the compiled bytecode of this script is cached
+     */
+    std::filesystem::path getBytecodeCachePath() const;
 };
 
 class JsScriptLoggedEvent : public Event {
@@ -77,8 +153,26 @@ public:
 };
 
 class ScriptManager final {
+public:
+    // How many scripts get ticked at once; the rest wait in a queue
+    static constexpr size_t MAX_ACTIVE_SCRIPTS = 4;
+    // How many environments are kept ready so running a script doesn't 
+    // have to wait for one to be set up
+    static constexpr size_t WARM_ENVIRONMENTS = 2;
+
 private:
     std::vector<std::shared_ptr<JsScript>> m_scripts;
+    std::vector<std::shared_ptr<JsScript>> m_active;
+    std::deque<std::shared_ptr<JsScript>> m_queued;
+    std::vector<std::shared_ptr<JsScript::Environment>> m_warmEnvironments;
+    bool m_refillQueued = false;
+    // Which active script goes first next frame, so a script that hogs the 
+    // budget can't starve the ones after it
+    size_t m_nextActive = 0;
+    bool m_ticking = false;
+
+    void promoteQueued();
+    void updateTicking();
 
 public:
     static ScriptManager* get();
@@ -87,5 +181,44 @@ public:
 
     void reloadScripts();
 
-    bool tickAll();
+    /**
+     * Where compiled scripts are cached so they don't need to be compiled 
+     * again on every run
+     */
+    static std::filesystem::path getBytecodeCacheDir();
+
+    /**
+     * Fill up the pool of environments ready for scripts to run in
+     */
+    void prewarm();
+    /**
+     * Get an environment to run a script in. Taken from the pool if one is 
+     * ready, and the pool is refilled on the next frame
+     */
+    Result<std::shared_ptr<JsScript::Environment>> takeEnvironment();
+
+    /**
+     * Keep ticking a script that has started running until it finishes. 
+     * The editor is only ticked while there are scripts scheduled
+     */
+    void schedule(std::shared_ptr<JsScript> script);
+    /**
+     * Cancel all running and queued scripts
+     */
+    void cancelAll();
+
+    size_t getActiveCount() const;
+    size_t getQueuedCount() const;
+
+    /**
+     * How long all active scripts may run for in total each frame, from 
+     * the `script-frame-budget` setting
+     */
+    static std::chrono::steady_clock::duration getFrameBudget();
+
+    /**
+     * Resume the active scripts in turn, splitting the frame's budget 
+     * between them
+     */
+    void tick();
 };
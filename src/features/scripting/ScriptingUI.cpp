@@ -2,6 +2,7 @@
 #include <Geode/modify/EditorUI.hpp>
 #include <Geode/ui/TextArea.hpp>
 #include <Geode/ui/Notification.hpp>
+#include <Geode/binding/ButtonSprite.hpp>
 #include <Geode/utils/ColorProvider.hpp>
 #include <utils/Editor.hpp>
 
@@ -186,8 +187,28 @@ bool RunScriptPopup::setup() {
     );
     m_buttonMenu->addChildAtPosition(reloadBtn, Anchor::BottomLeft, ccp(20, 20));
 
+    m_progressLabel = CCLabelBMFont::create("", "goldFont.fnt");
+    m_mainLayer->addChildAtPosition(
+        m_progressLabel, Anchor::BottomRight,
+        ccp(-m_logsList->getContentWidth() / 2 - 25, 18)
+    );
+
+    auto cancelSpr = ButtonSprite::create("Cancel", "goldFont.fnt", "GJ_button_06.png", .8f);
+    cancelSpr->setScale(.5f);
+    m_cancelBtn = CCMenuItemSpriteExtra::create(
+        cancelSpr, this, menu_selector(RunScriptPopup::onCancel)
+    );
+    m_buttonMenu->addChildAtPosition(m_cancelBtn, Anchor::BottomRight, ccp(-40, 18));
+
+    // Long-running scripts are paused between frames, so keep their 
+    // progress up to date while they run
+    this->schedule(schedule_selector(RunScriptPopup::updateProgress), .1f);
+
     m_logListener.bind(this, &RunScriptPopup::onLogged);
 
+    // Get environments ready for when a script is run
+    ScriptManager::get()->prewarm();
+
     // On first boot try reloading scripts fully
     static bool LOADED_SCRIPTS = false;
     if (!LOADED_SCRIPTS) {
@@ -262,9 +283,42 @@ void RunScriptPopup::updateLogs() {
     m_logsList->m_contentLayer->updateLayout();
 }
 
+void RunScriptPopup::updateProgress(float) {
+    auto selected = s_selected.lock();
+    bool running = selected && selected->isRunning();
+    m_progressLabel->setVisible(running);
+    m_cancelBtn->setVisible(running);
+    if (!running) {
+        return;
+    }
+    auto seconds = std::chrono::duration<float>(selected->getRunTime()).count();
+    if (auto progress = selected->getProgress()) {
+        m_progressLabel->setString(fmt::format("Running... {:.0f}% ({:.1f}s)", *progress * 100, seconds).c_str());
+    }
+    else {
+        m_progressLabel->setString(fmt::format("Running... ({:.1f}s)", seconds).c_str());
+    }
+    m_progressLabel->limitLabelWidth(m_logsList->getContentWidth() - 50, .4f, .1f);
+}
+
 void RunScriptPopup::onLogged(JsScriptLoggedEvent*) {
     this->updateLogs();
 }
+void RunScriptPopup::onCancel(CCObject*) {
+    if (auto selected = s_selected.lock()) {
+        selected->cancel();
+    }
+    this->updateProgress();
+}
+void RunScriptPopup::onClose(CCObject* sender) {
+    // Scripts are paused between frames, and editing the level while one is 
+    // paused could pull objects out from under it
+    if (ScriptManager::get()->getActiveCount() > 0 || ScriptManager::get()->getQueuedCount() > 0) {
+        Notification::create("Wait for the scripts to finish or cancel them first", NotificationIcon::Warning)->show();
+        return;
+    }
+    Popup::onClose(sender);
+}
 void RunScriptPopup::onReload(CCObject* sender) {
     s_selected.reset();
     ScriptManager::get()->reloadScripts();
@@ -287,6 +341,7 @@ RunScriptPopup* RunScriptPopup::create() {
 void RunScriptPopup::view(std::shared_ptr<JsScript> script) {
     s_selected = script;
     this->updateLogs();
+    this->updateProgress();
     m_logListener.setFilter(JsScriptLoggedFilter(script));
     for (auto node : CCArrayExt<ScriptNode*>(m_list->m_contentLayer->getChildren())) {
         node->updateState();
@@ -40,15 +40,20 @@ class RunScriptPopup : public Popup<> {
 protected:
     ScrollLayer* m_list;
     ScrollLayer* m_logsList;
+    CCLabelBMFont* m_progressLabel;
+    CCMenuItemSpriteExtra* m_cancelBtn;
     EventListener<JsScriptLoggedFilter> m_logListener;
     static std::weak_ptr<JsScript> s_selected;
 
     bool setup() override;
     void reloadList();
     void updateLogs();
+    void updateProgress(float = 0);
 
     void onLogged(JsScriptLoggedEvent* ev);
     void onReload(CCObject*);
+    void onCancel(CCObject*);
+    void onClose(CCObject*) override;
 
     friend class ScriptNode;
 
@@ -0,0 +1,115 @@
+#include "Compression.hpp"
+#include <zlib.h>
+#include <fstream>
+#include <array>
+
+// Files start with the magic followed by the uncompressed size as a 64-bit 
+// little-endian integer, and then the zlib stream
+static constexpr std::string_view MAGIC = "BEZ1";
+static constexpr size_t HEADER_SIZE = MAGIC.size() + sizeof(uint64_t);
+static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+Result<> be::writeCompressed(std::filesystem::path const& path, std::string_view data, int level) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return Err("Unable to open file");
+    }
+
+    std::array<char, HEADER_SIZE> header;
+    std::copy(MAGIC.begin(), MAGIC.end(), header.begin());
+    for (size_t i = 0; i < sizeof(uint64_t); i += 1) {
+        header[MAGIC.size() + i] = static_cast<char>(static_cast<uint64_t>(data.size()) >> (i * 8));
+    }
+    file.write(header.data(), header.size());
+
+    z_stream stream {};
+    if (deflateInit(&stream, std::clamp(level, 0, 9)) != Z_OK) {
+        return Err("Unable to start compressing");
+    }
+    std::vector<Bytef> out(BLOCK_SIZE);
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END) {
+        // zlib sizes are only 32-bit, so the input is fed in in blocks too
+        if (stream.avail_in == 0 && !data.empty()) {
+            const auto size = std::min(data.size(), BLOCK_SIZE);
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+            stream.avail_in = static_cast<uInt>(size);
+            data.remove_prefix(size);
+        }
+        stream.next_out = out.data();
+        stream.avail_out = static_cast<uInt>(out.size());
+        ret = deflate(&stream, data.empty() ? Z_FINISH : Z_NO_FLUSH);
+        if (ret == Z_STREAM_ERROR) {
+            break;
+        }
+        file.write(reinterpret_cast<char const*>(out.data()), out.size() - stream.avail_out);
+    }
+    deflateEnd(&stream);
+
+    if (ret != Z_STREAM_END) {
+        return Err("Unable to compress data");
+    }
+    if (!file) {
+        return Err("Unable to write file");
+    }
+    return Ok();
+}
+
+Result<> be::readCompressed(std::filesystem::path const& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return Err("Unable to open file");
+    }
+
+    std::array<char, HEADER_SIZE> header;
+    file.read(header.data(), header.size());
+    if (file.gcount() < static_cast<std::streamsize>(header.size()) || std::string_view(header.data(), MAGIC.size()) != MAGIC) {
+        file.clear();
+        file.seekg(0);
+        out.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return Ok();
+    }
+    uint64_t size = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); i += 1) {
+        size |= static_cast<uint64_t>(static_cast<uint8_t>(header[MAGIC.size() + i])) << (i * 8);
+    }
+    if (size > std::numeric_limits<uInt>::max()) {
+        return Err("Compressed file is too large");
+    }
+
+    // Inflate directly into the space reserved at the end of the output
+    const auto start = out.size();
+    out.resize(start + size);
+    z_stream stream {};
+    if (inflateInit(&stream) != Z_OK) {
+        out.resize(start);
+        return Err("Unable to start decompressing");
+    }
+    stream.next_out = reinterpret_cast<Bytef*>(out.data() + start);
+    stream.avail_out = static_cast<uInt>(size);
+
+    std::vector<char> in(BLOCK_SIZE);
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END) {
+        if (stream.avail_in == 0) {
+            file.read(in.data(), in.size());
+            stream.next_in = reinterpret_cast<Bytef*>(in.data());
+            stream.avail_in = static_cast<uInt>(file.gcount());
+            if (stream.avail_in == 0) {
+                break;
+            }
+        }
+        ret = inflate(&stream, Z_NO_FLUSH);
+        if (ret != Z_OK) {
+            break;
+        }
+    }
+    const bool complete = ret == Z_STREAM_END && stream.avail_out == 0;
+    inflateEnd(&stream);
+
+    if (!complete) {
+        out.resize(start);
+        return Err("Compressed file is corrupted");
+    }
+    return Ok();
+}
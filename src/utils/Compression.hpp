@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <filesystem>
+#include <string_view>
+
+using namespace geode::prelude;
+
+namespace be {
+    constexpr int DEFAULT_COMPRESSION_LEVEL = 6;
+
+    /**
+     * Write data into a deflate-compressed file with a small header. The data 
+     * is compressed one block at a time as it is written, so there's never a 
+     * full compressed copy of it in memory
+     * @param level Compression level from 0 (none) to 9 (smallest)
+     */
+    Result<> writeCompressed(std::filesystem::path const& path, std::string_view data, int level = DEFAULT_COMPRESSION_LEVEL);
+    /**
+     * Decompress a file written with `writeCompressed` straight onto the end 
+     * of `out`. Files that aren't compressed get appended as-is
+     */
+    Result<> readCompressed(std::filesystem::path const& path, std::string& out);
+}
@@ -1,5 +1,6 @@
 #include "Editor.hpp"
 #include "ObjectIDs.hpp"
+#include "GroupIndex.hpp"
 #include <Geode/modify/GameManager.hpp>
 #include <Geode/modify/EditorUI.hpp>
 #include <Geode/modify/EditorPauseLayer.hpp>
@@ -348,12 +349,65 @@ void be::focusEditor(EditorUI* ui, CCRect const& rect, bool smooth) {
 void be::focusEditorOnObjects(EditorUI* ui, CCArray* objs, bool smooth) {
     return focusEditor(ui, calculateCoverageButActuallyGood(objs), smooth);
 }
+void be::forEachObjectByStringIndex(
+    LevelEditorLayer* lel, std::vector<int> const& objectIDs,
+    std::function<void(GameObject*, size_t)> const& func
+) {
+    // How far ahead to look for an object's ID before giving up on it
+    constexpr size_t MAX_SKIPPED_OBJECTS = 16;
+
+    // The editor creates objects in the same order as they are in the level 
+    // string, but skips any that fail to load, so the IDs are used to keep 
+    // the two lined up
+    size_t stringIndex = 0;
+    for (auto obj : CCArrayExt<GameObject*>(lel->m_objects)) {
+        if (stringIndex >= objectIDs.size()) {
+            break;
+        }
+        const auto lookahead = std::min(objectIDs.size(), stringIndex + MAX_SKIPPED_OBJECTS);
+        std::optional<size_t> match;
+        for (auto i = stringIndex; i < lookahead; i += 1) {
+            if (objectIDs[i] == obj->m_objectID) {
+                match = i;
+                break;
+            }
+        }
+        // Guessing the index of an object that can't be found would hand 
+        // the caller some other object's string
+        if (!match) {
+            continue;
+        }
+        func(obj, *match);
+        stringIndex = *match + 1;
+    }
+}
+CCArray* be::findObjectsByStringIndex(
+    LevelEditorLayer* lel,
+    std::vector<int> const& objectIDs, std::vector<size_t> const& indices
+) {
+    auto objs = CCArray::create();
+    size_t nextIndex = 0;
+    forEachObjectByStringIndex(lel, objectIDs, [&](GameObject* obj, size_t stringIndex) {
+        while (nextIndex < indices.size() && indices[nextIndex] < stringIndex) {
+            nextIndex += 1;
+        }
+        if (nextIndex < indices.size() && indices[nextIndex] == stringIndex) {
+            objs->addObject(obj);
+            nextIndex += 1;
+        }
+    });
+    return objs;
+}
 
 CCArray* be::getObjectsFromGroupDict(CCDictionary* groupDict, int id) {
     // Don't waste time on invalid triggers
     if (id <= 0 || id > 9999) {
         return nullptr;
     }
+    // The group index knows which groups are empty without a dict lookup
+    if (auto index = GroupIndex::get(); index && LevelEditorLayer::get()->m_groupDict == groupDict) {
+        return index->getObjectsInGroup(id);
+    }
     auto objs = static_cast<CCArray*>(groupDict->objectForKey(id));
     // Don't waste time on null or empty array
     if (!objs || !objs->count()) {
@@ -382,9 +436,9 @@ CCPoint be::OutputSlots::calculateSlotPosition(EffectGameObject* trigger, size_t
     return doCalculateSlotPosition(trigger, slotCount, slotIndex, 1);
 }
 
-std::pair<be::InputSlots, be::OutputSlots> be::getTriggerSlots(EffectGameObject* trigger) {
+std::pair<be::InputSlots, be::OutputSlots> be::getTriggerSlots(int objectID) {
     using namespace object_ids;
-    switch (trigger->m_objectID) {
+    switch (objectID) {
         case MOVE_TRIGGER: {
             return std::make_pair(
                 be::InputSlots {
@@ -409,6 +463,20 @@ std::pair<be::InputSlots, be::OutputSlots> be::getTriggerSlots(EffectGameObject*
             );
         } break;
 
+        // The target color channel of color triggers has its own property, 
+        // and the target ID of item edit triggers is an item ID
+        case COLOR_TRIGGER: case ITEM_EDIT_TRIGGER: {
+            return std::make_pair(
+                be::InputSlots {
+                    .targetGroupID = SlotType::Generic,
+                },
+                be::OutputSlots {
+                    .targetGroupID = std::nullopt,
+                    .centerGroupID = std::nullopt,
+                }
+            );
+        } break;
+
         default: {
             return std::make_pair(
                 be::InputSlots {
@@ -422,6 +490,9 @@ std::pair<be::InputSlots, be::OutputSlots> be::getTriggerSlots(EffectGameObject*
         } break;
     }
 }
+std::pair<be::InputSlots, be::OutputSlots> be::getTriggerSlots(EffectGameObject* trigger) {
+    return getTriggerSlots(trigger->m_objectID);
+}
 std::vector<int> be::getTriggerTargetedGroups(EffectGameObject* trigger) {
     auto [_, slots] = getTriggerSlots(trigger);
     std::vector<int> results;
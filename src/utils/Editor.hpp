@@ -36,6 +36,25 @@ namespace be {
 
     void focusEditor(EditorUI* ui, CCRect const& rect, bool smooth);
     void focusEditorOnObjects(EditorUI* ui, CCArray* objs, bool smooth);
+    /**
+     * Line up the objects in the editor with the objects of the level string 
+     * they were created from. `objectIDs` are the IDs of every object in the 
+     * level string in order, and `func` gets called with each object and its 
+     * index in the level string. Objects that can't be lined up are skipped, 
+     * so `objectIDs[index]` is always the object's ID
+     */
+    void forEachObjectByStringIndex(
+        LevelEditorLayer* lel, std::vector<int> const& objectIDs,
+        std::function<void(GameObject*, size_t)> const& func
+    );
+    /**
+     * Find the objects the editor created from the given objects of its level 
+     * string. `indices` must be sorted
+     */
+    CCArray* findObjectsByStringIndex(
+        LevelEditorLayer* lel,
+        std::vector<int> const& objectIDs, std::vector<size_t> const& indices
+    );
 
     CCArray* getObjectsFromGroupDict(CCDictionary* groupDict, int groupID);
 
@@ -56,6 +75,13 @@ namespace be {
 
         CCPoint calculateSlotPosition(EffectGameObject* trigger, size_t slotIndex) const;
     };
+    /**
+     * Get which slots a trigger with this object ID has. Slots only exist 
+     * for properties that hold groups. Triggers whose target is a group or 
+     * something else depending on their settings, like pulse triggers, are 
+     * assumed to target a group
+     */
+    std::pair<InputSlots, OutputSlots> getTriggerSlots(int objectID);
     std::pair<InputSlots, OutputSlots> getTriggerSlots(EffectGameObject* trigger);
     std::vector<int> getTriggerTargetedGroups(EffectGameObject* trigger);
 }
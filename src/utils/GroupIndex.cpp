@@ -0,0 +1,263 @@
+#include "GroupIndex.hpp"
+#include "Editor.hpp"
+#include <Geode/modify/LevelEditorLayer.hpp>
+#include <Geode/modify/EditorUI.hpp>
+#include <Geode/utils/cocos.hpp>
+
+class $modify(GroupIndexLayer, LevelEditorLayer) {
+    struct Fields {
+        be::GroupIndex index;
+    };
+
+    $override
+    bool init(GJGameLevel* level, bool p1) {
+        if (!LevelEditorLayer::init(level, p1))
+            return false;
+
+        // All of the level's objects have been loaded in by now
+        m_fields->index.rebuild(this);
+
+        return true;
+    }
+
+    $override
+    void addToGroup(GameObject* obj, int group, bool p2) {
+        LevelEditorLayer::addToGroup(obj, group, p2);
+        m_fields->index.updateMemberCount(group);
+    }
+    $override
+    void removeFromGroup(GameObject* obj, int group) {
+        LevelEditorLayer::removeFromGroup(obj, group);
+        m_fields->index.updateMemberCount(group);
+    }
+    $override
+    void addSpecial(GameObject* obj) {
+        LevelEditorLayer::addSpecial(obj);
+        if (auto trigger = typeinfo_cast<EffectGameObject*>(obj)) {
+            m_fields->index.updateTrigger(trigger);
+        }
+    }
+    $override
+    void removeSpecial(GameObject* obj) {
+        LevelEditorLayer::removeSpecial(obj);
+        if (auto trigger = typeinfo_cast<EffectGameObject*>(obj)) {
+            m_fields->index.removeTrigger(trigger);
+        }
+    }
+};
+
+// Trigger settings can only be edited (through popups, paste state, etc.) 
+// while the trigger is selected
+class $modify(EditorUI) {
+    $override
+    void selectObject(GameObject* obj, bool filter) {
+        if (auto index = be::GroupIndex::get(); obj && index) {
+            index->markTriggerDirty(obj);
+        }
+        EditorUI::selectObject(obj, filter);
+    }
+    $override
+    void selectObjects(CCArray* objs, bool ignoreFilters) {
+        if (auto index = be::GroupIndex::get(); objs && index) {
+            for (auto obj : CCArrayExt<GameObject*>(objs)) {
+                index->markTriggerDirty(obj);
+            }
+        }
+        EditorUI::selectObjects(objs, ignoreFilters);
+    }
+    $override
+    void deselectObject(GameObject* obj) {
+        if (auto index = be::GroupIndex::get(); obj && index) {
+            index->markTriggerDirty(obj);
+        }
+        EditorUI::deselectObject(obj);
+    }
+    $override
+    void deselectAll() {
+        if (auto index = be::GroupIndex::get()) {
+            if (m_selectedObject) {
+                index->markTriggerDirty(m_selectedObject);
+            }
+            for (auto obj : CCArrayExt<GameObject*>(m_selectedObjects)) {
+                index->markTriggerDirty(obj);
+            }
+        }
+        EditorUI::deselectAll();
+    }
+};
+
+static bool isValidGroup(int group) {
+    return group > 0 && group <= be::GroupIndex::MAX_GROUP_ID;
+}
+
+be::GroupIndex* be::GroupIndex::get() {
+    auto lel = LevelEditorLayer::get();
+    if (!lel) {
+        return nullptr;
+    }
+    auto index = &static_cast<GroupIndexLayer*>(lel)->m_fields->index;
+    // Not ready until the editor has finished loading
+    if (!index->m_editor) {
+        return nullptr;
+    }
+    return index;
+}
+
+void be::GroupIndex::rebuild(LevelEditorLayer* editor) {
+    m_editor = editor;
+    for (int group = 1; group <= MAX_GROUP_ID; group += 1) {
+        m_usedGroups.remove(group, m_memberCounts[group]);
+    }
+    m_memberCounts.fill(0);
+    m_totalMemberships = 0;
+
+    CCDictElement* element;
+    CCDICT_FOREACH(m_editor->m_groupDict, element) {
+        const auto group = static_cast<int>(element->getIntKey());
+        if (isValidGroup(group)) {
+            const auto count = static_cast<CCArray*>(element->getObject())->count();
+            m_memberCounts[group] = count;
+            m_totalMemberships += count;
+            m_usedGroups.add(group, count);
+        }
+    }
+
+    for (auto& [trigger, indexed] : m_triggers) {
+        this->unindexTrigger(trigger, indexed);
+    }
+    m_triggers.clear();
+    m_dirtyTriggers.clear();
+    for (auto obj : CCArrayExt<GameObject*>(m_editor->m_objects)) {
+        if (auto trigger = typeinfo_cast<EffectGameObject*>(obj)) {
+            this->updateTrigger(trigger);
+        }
+    }
+}
+void be::GroupIndex::updateMemberCount(int group) {
+    // Everything gets counted at once after the level has loaded
+    if (!m_editor || !isValidGroup(group)) {
+        return;
+    }
+    // Read the count back from the group dict instead of just incrementing
+    // and decrementing so this can never drift out of sync with it
+    const auto objs = static_cast<CCArray*>(m_editor->m_groupDict->objectForKey(group));
+    const uint32_t count = objs ? objs->count() : 0;
+    m_totalMemberships = m_totalMemberships - m_memberCounts[group] + count;
+    m_usedGroups.remove(group, m_memberCounts[group]);
+    m_usedGroups.add(group, count);
+    m_memberCounts[group] = count;
+}
+void be::GroupIndex::updateTrigger(EffectGameObject* trigger) {
+    // Everything gets indexed at once after the level has loaded
+    if (!m_editor) {
+        return;
+    }
+    const auto slots = be::getTriggerSlots(trigger).second;
+    const auto current = IndexedTrigger {
+        .targetedGroups = {
+            slots.targetGroupID ? trigger->m_targetGroupID : 0,
+            slots.centerGroupID ? trigger->m_centerGroupID : 0,
+        },
+        .referencedGroups = { trigger->m_targetGroupID, trigger->m_centerGroupID },
+    };
+    auto [it, inserted] = m_triggers.try_emplace(trigger, current);
+    if (!inserted) {
+        if (it->second == current) {
+            return;
+        }
+        this->unindexTrigger(trigger, it->second);
+        it->second = current;
+    }
+    this->indexTrigger(trigger, current);
+}
+void be::GroupIndex::removeTrigger(EffectGameObject* trigger) {
+    m_dirtyTriggers.erase(trigger);
+    if (auto it = m_triggers.find(trigger); it != m_triggers.end()) {
+        this->unindexTrigger(trigger, it->second);
+        m_triggers.erase(it);
+    }
+}
+void be::GroupIndex::markTriggerDirty(GameObject* obj) {
+    if (auto trigger = typeinfo_cast<EffectGameObject*>(obj); trigger && m_triggers.contains(trigger)) {
+        m_newDirtyTriggers |= m_dirtyTriggers.insert(trigger).second;
+    }
+}
+
+void be::GroupIndex::indexTrigger(EffectGameObject* trigger, IndexedTrigger const& indexed) {
+    for (size_t i = 0; i < indexed.targetedGroups.size(); i += 1) {
+        const auto group = indexed.targetedGroups[i];
+        // Triggers that target the same group with both slots are only listed once
+        if (isValidGroup(group) && (i == 0 || group != indexed.targetedGroups[0])) {
+            m_triggersTargeting[group].push_back(trigger);
+        }
+    }
+    for (auto group : indexed.referencedGroups) {
+        m_usedGroups.add(group);
+    }
+}
+void be::GroupIndex::unindexTrigger(EffectGameObject* trigger, IndexedTrigger const& indexed) {
+    for (size_t i = 0; i < indexed.targetedGroups.size(); i += 1) {
+        const auto group = indexed.targetedGroups[i];
+        if (isValidGroup(group) && (i == 0 || group != indexed.targetedGroups[0])) {
+            auto& triggers = m_triggersTargeting[group];
+            std::erase(triggers, trigger);
+            if (triggers.empty()) {
+                m_triggersTargeting.erase(group);
+            }
+        }
+    }
+    for (auto group : indexed.referencedGroups) {
+        m_usedGroups.remove(group);
+    }
+}
+void be::GroupIndex::syncTriggers() {
+    // Triggers that are still selected may still be edited, so they are 
+    // checked again at most once per frame for as long as they stay selected
+    const auto frame = CCDirector::get()->getTotalFrames();
+    if (m_dirtyTriggers.empty() || (!m_newDirtyTriggers && frame == m_lastSyncedFrame)) {
+        return;
+    }
+    m_newDirtyTriggers = false;
+    m_lastSyncedFrame = frame;
+
+    for (auto it = m_dirtyTriggers.begin(); it != m_dirtyTriggers.end();) {
+        this->updateTrigger(*it);
+        if ((*it)->m_isSelected) {
+            ++it;
+        }
+        else {
+            it = m_dirtyTriggers.erase(it);
+        }
+    }
+}
+
+CCArray* be::GroupIndex::getObjectsInGroup(int group) const {
+    if (!this->getObjectCountInGroup(group)) {
+        return nullptr;
+    }
+    return static_cast<CCArray*>(m_editor->m_groupDict->objectForKey(group));
+}
+size_t be::GroupIndex::getObjectCountInGroup(int group) const {
+    return isValidGroup(group) ? m_memberCounts[group] : 0;
+}
+size_t be::GroupIndex::getTotalMemberships() const {
+    return m_totalMemberships;
+}
+std::span<EffectGameObject* const> be::GroupIndex::getTriggersTargeting(int group) {
+    this->syncTriggers();
+    if (auto triggers = m_triggersTargeting.find(group); triggers != m_triggersTargeting.end()) {
+        return triggers->second;
+    }
+    return {};
+}
+bool be::GroupIndex::isGroupUsed(int group) {
+    if (!isValidGroup(group)) {
+        return false;
+    }
+    this->syncTriggers();
+    return m_usedGroups.isUsed(group);
+}
+be::UsedIDBitset const& be::GroupIndex::getUsedGroups() {
+    this->syncTriggers();
+    return m_usedGroups;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Geode/binding/LevelEditorLayer.hpp>
+#include <Geode/binding/EffectGameObject.hpp>
+#include "UsedIDs.hpp"
+#include <span>
+#include <unordered_set>
+
+using namespace geode::prelude;
+
+namespace be {
+    /**
+     * Index of how groups are used in the current editor. Group memberships
+     * are kept up to date by hooks whenever objects are added to or removed
+     * from groups. Triggers are indexed when they are added to or removed
+     * from the level. Their settings get edited directly by too many
+     * different popups to hook them all, but they have to be selected to be
+     * edited, so only triggers that are or were selected since the last
+     * query are checked again
+     */
+    class GroupIndex final {
+    public:
+        static constexpr int MAX_GROUP_ID = 9999;
+
+    protected:
+        struct IndexedTrigger final {
+            // Groups targeted through the trigger's output slots, 0 if none
+            std::array<int, 2> targetedGroups;
+            // Raw IDs which may be set even if the trigger doesn't use them
+            std::array<int, 2> referencedGroups;
+
+            bool operator==(IndexedTrigger const&) const = default;
+        };
+
+        LevelEditorLayer* m_editor = nullptr;
+        std::array<uint32_t, MAX_GROUP_ID + 1> m_memberCounts {};
+        // Counts both memberships and references from triggers
+        UsedIDBitset m_usedGroups { 1, MAX_GROUP_ID };
+        size_t m_totalMemberships = 0;
+        std::unordered_map<int, std::vector<EffectGameObject*>> m_triggersTargeting;
+        std::unordered_map<EffectGameObject*, IndexedTrigger> m_triggers;
+        // Triggers whose settings may have changed since they were indexed
+        std::unordered_set<EffectGameObject*> m_dirtyTriggers;
+        bool m_newDirtyTriggers = false;
+        unsigned int m_lastSyncedFrame = 0;
+
+        void indexTrigger(EffectGameObject* trigger, IndexedTrigger const& indexed);
+        void unindexTrigger(EffectGameObject* trigger, IndexedTrigger const& indexed);
+        void syncTriggers();
+
+    public:
+        /**
+         * Get the index for the current editor, or null if not in the editor
+         */
+        static GroupIndex* get();
+
+        /**
+         * Recount all group memberships from the editor's group dictionary
+         */
+        void rebuild(LevelEditorLayer* editor);
+        void updateMemberCount(int group);
+        /**
+         * Index a trigger, or update it if its target groups have changed
+         */
+        void updateTrigger(EffectGameObject* trigger);
+        void removeTrigger(EffectGameObject* trigger);
+        /**
+         * Check the object's target groups again the next time the index is
+         * queried. Does nothing if the object isn't a trigger
+         */
+        void markTriggerDirty(GameObject* obj);
+
+        /**
+         * Get the objects in a group, or null if the group has no objects
+         */
+        CCArray* getObjectsInGroup(int group) const;
+        size_t getObjectCountInGroup(int group) const;
+        size_t getTotalMemberships() const;
+        std::span<EffectGameObject* const> getTriggersTargeting(int group);
+        /**
+         * Check if any object is in the group or any trigger references it
+         */
+        bool isGroupUsed(int group);
+        UsedIDBitset const& getUsedGroups();
+    };
+}
@@ -0,0 +1,218 @@
+#include "GroupRemap.hpp"
+#include "Editor.hpp"
+#include "ObjectIDs.hpp"
+#include <charconv>
+#include <ranges>
+
+// Object string keys
+static constexpr std::string_view KEY_OBJECT_ID = "1";
+static constexpr std::string_view KEY_GROUPS = "57";
+static constexpr std::string_view KEY_TARGET_GROUP = "51";
+static constexpr std::string_view KEY_CENTER_GROUP = "71";
+static constexpr std::string_view KEY_PULSE_TARGET_TYPE = "52";
+
+static std::optional<int> parseGroup(std::string_view str) {
+    int value;
+    auto [end, err] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (err != std::errc() || end != str.data() + str.size()) {
+        return std::nullopt;
+    }
+    if (value <= 0 || value > be::GroupRemap::MAX_GROUP_ID) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Calls `func(key, value)` for every property in an object string and builds
+// a new string where each value has been replaced by what `func` wrote into
+// the output, or copied as-is if `func` returned false. Objects are separated
+// by `;` and their keys and values by `,`
+template <class F>
+static void forEachProperty(std::string_view objects, std::string* out, F&& func) {
+    std::string_view key;
+    bool isKey = true;
+    size_t pos = 0;
+    while (pos < objects.size()) {
+        auto end = objects.find_first_of(",;", pos);
+        if (end == std::string_view::npos) {
+            end = objects.size();
+        }
+        const auto token = objects.substr(pos, end - pos);
+        if (isKey) {
+            key = token;
+        }
+        if (isKey || !func(key, token)) {
+            if (out) out->append(token);
+        }
+        if (end < objects.size()) {
+            if (out) out->push_back(objects[end]);
+            // A new object always starts with a key
+            isKey = objects[end] == ';' ? true : !isKey;
+        }
+        pos = end + 1;
+    }
+}
+
+struct GroupTargets final {
+    bool target = false;
+    bool center = false;
+};
+// The target and center properties of an object only hold groups if it's a 
+// trigger that has slots for them
+static GroupTargets getGroupTargets(std::string_view object) {
+    std::optional<int> objectID;
+    bool pulseTargetsGroup = false;
+    forEachProperty(object, nullptr, [&](std::string_view key, std::string_view value) {
+        if (key == KEY_OBJECT_ID) {
+            int id;
+            if (std::from_chars(value.data(), value.data() + value.size(), id).ec == std::errc()) {
+                objectID = id;
+            }
+        }
+        else if (key == KEY_PULSE_TARGET_TYPE) {
+            pulseTargetsGroup = value == "1";
+        }
+        return false;
+    });
+    if (!objectID) {
+        return GroupTargets();
+    }
+    // Pulse triggers target a color channel unless set to target a group
+    if (*objectID == object_ids::PULSE_TRIGGER && !pulseTargetsGroup) {
+        return GroupTargets();
+    }
+    const auto slots = be::getTriggerSlots(*objectID).second;
+    return GroupTargets {
+        .target = slots.targetGroupID.has_value(),
+        .center = slots.centerGroupID.has_value(),
+    };
+}
+
+be::GroupRemap::GroupRemap() : m_mapping(MAX_GROUP_ID + 1, 0) {}
+
+be::GroupRemap be::GroupRemap::gather(std::string_view objects) {
+    auto remap = GroupRemap();
+    forEachProperty(objects, nullptr, [&](std::string_view key, std::string_view value) {
+        if (key != KEY_GROUPS) {
+            return false;
+        }
+        for (auto part : std::views::split(value, '.')) {
+            if (auto group = parseGroup(std::string_view(part.begin(), part.end()))) {
+                // Mark as gathered, the actual new ID is picked in allocate
+                if (remap.m_mapping[*group] == 0) {
+                    remap.m_mapping[*group] = -1;
+                    remap.m_groups.push_back(*group);
+                }
+            }
+        }
+        return false;
+    });
+    std::sort(remap.m_groups.begin(), remap.m_groups.end());
+    return remap;
+}
+
+Result<> be::GroupRemap::allocate(UsedIDBitset const& used) {
+    if (m_groups.empty()) {
+        return Ok();
+    }
+    const int count = static_cast<int>(m_groups.size());
+
+    // Look for the first run of free IDs long enough to fit every group
+    std::optional<int> block;
+    for (int start = used.findNextFree(1); !used.isUsed(start);) {
+        int end = start;
+        while (end - start + 1 < count && end < MAX_GROUP_ID && !used.isUsed(end + 1)) {
+            end += 1;
+        }
+        if (end - start + 1 == count) {
+            block = start;
+            break;
+        }
+        if (end >= MAX_GROUP_ID) {
+            break;
+        }
+        start = used.findNextFree(end + 1);
+    }
+
+    std::vector<int> fresh;
+    fresh.reserve(count);
+    if (block) {
+        for (int id = *block; id < *block + count; id += 1) {
+            fresh.push_back(id);
+        }
+    }
+    else {
+        for (int id = 1; id <= MAX_GROUP_ID && fresh.size() < m_groups.size(); id += 1) {
+            if (!used.isUsed(id)) {
+                fresh.push_back(id);
+            }
+        }
+    }
+    if (fresh.size() < m_groups.size()) {
+        return Err("Not enough free groups (need {}, only {} free)", count, fresh.size());
+    }
+    for (size_t i = 0; i < m_groups.size(); i += 1) {
+        m_mapping[m_groups[i]] = fresh[i];
+    }
+    return Ok();
+}
+
+std::string be::GroupRemap::apply(std::string_view objects) const {
+    std::string out;
+    out.reserve(objects.size() + objects.size() / 8);
+    size_t pos = 0;
+    while (pos < objects.size()) {
+        auto end = objects.find(';', pos);
+        if (end == std::string_view::npos) {
+            end = objects.size();
+        }
+        this->applyToObject(objects.substr(pos, end - pos), out);
+        if (end < objects.size()) {
+            out.push_back(';');
+        }
+        pos = end + 1;
+    }
+    return out;
+}
+void be::GroupRemap::applyToObject(std::string_view object, std::string& out) const {
+    const auto targets = getGroupTargets(object);
+    forEachProperty(object, &out, [&](std::string_view key, std::string_view value) {
+        if (
+            (key == KEY_TARGET_GROUP && targets.target) ||
+            (key == KEY_CENTER_GROUP && targets.center)
+        ) {
+            auto group = parseGroup(value);
+            if (!group || this->getNewID(*group) == *group) {
+                return false;
+            }
+            out.append(std::to_string(this->getNewID(*group)));
+            return true;
+        }
+        if (key == KEY_GROUPS) {
+            bool first = true;
+            for (auto part : std::views::split(value, '.')) {
+                if (!first) out.push_back('.');
+                first = false;
+                const auto str = std::string_view(part.begin(), part.end());
+                if (auto group = parseGroup(str)) {
+                    out.append(std::to_string(this->getNewID(*group)));
+                }
+                else {
+                    out.append(str);
+                }
+            }
+            return true;
+        }
+        return false;
+    });
+}
+
+size_t be::GroupRemap::getGroupCount() const {
+    return m_groups.size();
+}
+int be::GroupRemap::getNewID(int group) const {
+    if (group <= 0 || group > MAX_GROUP_ID || m_mapping[group] <= 0) {
+        return group;
+    }
+    return m_mapping[group];
+}
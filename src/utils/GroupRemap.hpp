@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include "UsedIDs.hpp"
+
+using namespace geode::prelude;
+
+namespace be {
+    /**
+     * Remaps the groups of a set of objects to fresh, unused ones. Works
+     * directly on object strings so objects can be given their new groups
+     * before they are even created, which avoids having to move thousands of
+     * existing objects between groups one by one.
+     *
+     * Remapping is done in three steps: `gather` finds every group the
+     * objects are in, `allocate` picks a new ID for each of them in one go,
+     * and `apply` rewrites all group, target group and center group
+     * references in a single sweep. Target and center groups that none of
+     * the objects are in are left alone, since those point to something
+     * outside of the objects. Target and center IDs of triggers that use
+     * them for something other than groups, like item IDs or color channels,
+     * are left alone too
+     */
+    class GroupRemap final {
+    public:
+        static constexpr int MAX_GROUP_ID = 9999;
+
+    protected:
+        // Indexed by the old group ID, 0 if the group is not remapped
+        std::vector<int> m_mapping;
+        std::vector<int> m_groups;
+
+        GroupRemap();
+
+        void applyToObject(std::string_view object, std::string& out) const;
+
+    public:
+        static GroupRemap gather(std::string_view objects);
+
+        /**
+         * Pick new IDs for the gathered groups. A contiguous block is used if
+         * one is free, otherwise the first free IDs
+         */
+        Result<> allocate(UsedIDBitset const& used);
+        std::string apply(std::string_view objects) const;
+
+        size_t getGroupCount() const;
+        int getNewID(int group) const;
+    };
+}
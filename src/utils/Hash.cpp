@@ -0,0 +1,110 @@
+#include "Hash.hpp"
+#include <bit>
+#include <cstring>
+#include <fmt/format.h>
+
+static constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5ull;
+
+static uint64_t read64(const char* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+static uint32_t read32(const char* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+static uint64_t xxRound(uint64_t acc, uint64_t input) {
+    acc += input * PRIME_2;
+    acc = std::rotl(acc, 31);
+    return acc * PRIME_1;
+}
+static uint64_t mergeRound(uint64_t acc, uint64_t value) {
+    acc ^= xxRound(0, value);
+    return acc * PRIME_1 + PRIME_4;
+}
+
+be::Hasher::Hasher(uint64_t seed)
+  : m_accs({ seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1 }),
+    m_seed(seed)
+{}
+
+void be::Hasher::update(std::string_view data) {
+    m_totalSize += data.size();
+
+    // Finish off a stripe left over from the last update first
+    if (m_bufferSize > 0) {
+        const auto fill = std::min(data.size(), m_buffer.size() - m_bufferSize);
+        std::memcpy(m_buffer.data() + m_bufferSize, data.data(), fill);
+        m_bufferSize += fill;
+        data.remove_prefix(fill);
+        if (m_bufferSize < m_buffer.size()) {
+            return;
+        }
+        for (size_t i = 0; i < 4; i += 1) {
+            m_accs[i] = xxRound(m_accs[i], read64(m_buffer.data() + i * 8));
+        }
+        m_bufferSize = 0;
+    }
+
+    while (data.size() >= 32) {
+        for (size_t i = 0; i < 4; i += 1) {
+            m_accs[i] = xxRound(m_accs[i], read64(data.data() + i * 8));
+        }
+        data.remove_prefix(32);
+    }
+
+    std::memcpy(m_buffer.data(), data.data(), data.size());
+    m_bufferSize = data.size();
+}
+uint64_t be::Hasher::digest() const {
+    uint64_t hash;
+    if (m_totalSize >= 32) {
+        hash = std::rotl(m_accs[0], 1) + std::rotl(m_accs[1], 7) + std::rotl(m_accs[2], 12) + std::rotl(m_accs[3], 18);
+        for (auto acc : m_accs) {
+            hash = mergeRound(hash, acc);
+        }
+    }
+    else {
+        hash = m_seed + PRIME_5;
+    }
+    hash += m_totalSize;
+
+    auto data = m_buffer.data();
+    auto size = m_bufferSize;
+    for (; size >= 8; data += 8, size -= 8) {
+        hash ^= xxRound(0, read64(data));
+        hash = std::rotl(hash, 27) * PRIME_1 + PRIME_4;
+    }
+    if (size >= 4) {
+        hash ^= read32(data) * PRIME_1;
+        hash = std::rotl(hash, 23) * PRIME_2 + PRIME_3;
+        data += 4;
+        size -= 4;
+    }
+    for (; size > 0; data += 1, size -= 1) {
+        hash ^= static_cast<uint8_t>(*data) * PRIME_5;
+        hash = std::rotl(hash, 11) * PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t be::hash64(std::string_view data) {
+    auto hasher = Hasher();
+    hasher.update(data);
+    return hasher.digest();
+}
+std::string be::hashToString(uint64_t hash) {
+    return fmt::format("{:016x}", hash);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <cstdint>
+
+namespace be {
+    /**
+     * Streaming 64-bit hash (XXH64) for fingerprinting large data like level
+     * strings. The result is the same on every platform, so it is safe to
+     * save hashes to disk and compare them later
+     */
+    class Hasher final {
+    protected:
+        std::array<uint64_t, 4> m_accs;
+        std::array<char, 32> m_buffer;
+        size_t m_bufferSize = 0;
+        uint64_t m_totalSize = 0;
+        uint64_t m_seed;
+
+    public:
+        explicit Hasher(uint64_t seed = 0);
+
+        void update(std::string_view data);
+        uint64_t digest() const;
+    };
+
+    uint64_t hash64(std::string_view data);
+    /**
+     * Format a hash as a fixed-length hex string
+     */
+    std::string hashToString(uint64_t hash);
+}
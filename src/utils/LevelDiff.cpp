@@ -0,0 +1,243 @@
+#include "LevelDiff.hpp"
+#include "Hash.hpp"
+#include <Geode/cocos/support/zip_support/ZipUtils.h>
+#include <charconv>
+#include <unordered_map>
+
+// What the base64 of a gzip header starts with
+static constexpr std::string_view COMPRESSED_PREFIX = "H4sI";
+
+// Object string keys
+static constexpr std::string_view KEY_OBJECT_ID = "1";
+static constexpr std::string_view KEY_X = "2";
+static constexpr std::string_view KEY_Y = "3";
+
+using ObjectRecord = be::LevelDiff::ObjectRecord;
+
+template <class T>
+static T parseNumber(std::string_view str) {
+    T value {};
+    std::from_chars(str.data(), str.data() + str.size(), value);
+    return value;
+}
+
+// Calls `func(key, value)` for every key-value pair in a comma-separated 
+// string like an object or the level settings
+template <class F>
+static void forEachPair(std::string_view str, F&& func) {
+    size_t pos = 0;
+    while (pos < str.size()) {
+        auto keyEnd = str.find(',', pos);
+        if (keyEnd == std::string_view::npos) {
+            break;
+        }
+        auto valueEnd = str.find(',', keyEnd + 1);
+        if (valueEnd == std::string_view::npos) {
+            valueEnd = str.size();
+        }
+        func(str.substr(pos, keyEnd - pos), str.substr(keyEnd + 1, valueEnd - keyEnd - 1));
+        pos = valueEnd + 1;
+    }
+}
+
+static ObjectRecord parseObject(std::string_view object, size_t offset) {
+    auto record = ObjectRecord {
+        .objectID = 0,
+        .x = 0,
+        .y = 0,
+        .hash = be::hash64(object),
+        .key = 0,
+        .shape = 0,
+        .offset = offset,
+        .length = object.size(),
+    };
+    std::string_view id, x, y;
+    auto shapeHasher = be::Hasher();
+    forEachPair(object, [&](std::string_view key, std::string_view value) {
+        if (key == KEY_X) x = value;
+        else if (key == KEY_Y) y = value;
+        else {
+            if (key == KEY_OBJECT_ID) id = value;
+            shapeHasher.update(key);
+            shapeHasher.update(",");
+            shapeHasher.update(value);
+            shapeHasher.update(",");
+        }
+    });
+    record.shape = shapeHasher.digest();
+    record.objectID = parseNumber<int>(id);
+    record.x = parseNumber<float>(x);
+    record.y = parseNumber<float>(y);
+
+    // Hashed as text so the key doesn't depend on float rounding
+    auto hasher = be::Hasher();
+    hasher.update(id);
+    hasher.update(",");
+    hasher.update(x);
+    hasher.update(",");
+    hasher.update(y);
+    record.key = hasher.digest();
+    return record;
+}
+
+// Splits a level string into its settings and its objects
+static std::string_view parseLevel(std::string_view level, std::vector<ObjectRecord>& objects) {
+    auto headerEnd = level.find(';');
+    if (headerEnd == std::string_view::npos) {
+        return level;
+    }
+    // Rough guess to avoid most of the reallocations
+    objects.reserve(level.size() / 48);
+    for (size_t pos = headerEnd + 1; pos < level.size();) {
+        auto end = level.find(';', pos);
+        if (end == std::string_view::npos) {
+            end = level.size();
+        }
+        if (end > pos) {
+            objects.push_back(parseObject(level.substr(pos, end - pos), pos));
+        }
+        pos = end + 1;
+    }
+    return level.substr(0, headerEnd);
+}
+
+static std::vector<std::string> diffSettings(std::string_view from, std::string_view to) {
+    std::unordered_map<std::string_view, std::string_view> fromSettings;
+    forEachPair(from, [&](std::string_view key, std::string_view value) {
+        fromSettings.emplace(key, value);
+    });
+    std::vector<std::string> changed;
+    forEachPair(to, [&](std::string_view key, std::string_view value) {
+        auto it = fromSettings.find(key);
+        if (it == fromSettings.end() || it->second != value) {
+            changed.emplace_back(key);
+        }
+        if (it != fromSettings.end()) {
+            fromSettings.erase(it);
+        }
+    });
+    // Whatever is left was removed
+    for (auto const& [key, _] : fromSettings) {
+        changed.emplace_back(key);
+    }
+    return changed;
+}
+
+be::LevelDiff be::LevelDiff::compute(std::string_view from, std::string_view to) {
+    auto diff = LevelDiff();
+    const auto fromHeader = parseLevel(from, diff.fromObjects);
+    const auto toHeader = parseLevel(to, diff.toObjects);
+    diff.changedSettings = diffSettings(fromHeader, toHeader);
+
+    // Lists of indices into `fromObjects`, popped from the back as they get 
+    // matched. Objects are pushed in reverse so that duplicates are matched 
+    // in the order they appear in
+    std::unordered_map<uint64_t, std::vector<size_t>> fromByHash;
+    fromByHash.reserve(diff.fromObjects.size());
+    for (size_t i = diff.fromObjects.size(); i-- > 0;) {
+        fromByHash[diff.fromObjects[i].hash].push_back(i);
+    }
+
+    std::vector<bool> fromMatched(diff.fromObjects.size(), false);
+    std::vector<size_t> unmatchedTo;
+    for (size_t i = 0; i < diff.toObjects.size(); i += 1) {
+        auto it = fromByHash.find(diff.toObjects[i].hash);
+        if (it != fromByHash.end() && !it->second.empty()) {
+            fromMatched[it->second.back()] = true;
+            diff.unchanged.push_back({ .from = it->second.back(), .to = i });
+            it->second.pop_back();
+        }
+        else {
+            unmatchedTo.push_back(i);
+        }
+    }
+
+    // Only the objects that weren't unchanged need to be matched by key
+    std::unordered_map<uint64_t, std::vector<size_t>> fromByKey;
+    for (size_t i = diff.fromObjects.size(); i-- > 0;) {
+        if (!fromMatched[i]) {
+            fromByKey[diff.fromObjects[i].key].push_back(i);
+        }
+    }
+    std::vector<size_t> unmatchedByKey;
+    for (auto i : unmatchedTo) {
+        auto it = fromByKey.find(diff.toObjects[i].key);
+        if (it != fromByKey.end() && !it->second.empty()) {
+            fromMatched[it->second.back()] = true;
+            diff.modified.push_back({ .from = it->second.back(), .to = i });
+            it->second.pop_back();
+        }
+        else {
+            unmatchedByKey.push_back(i);
+        }
+    }
+
+    // Then moved objects, which have everything but their position the same
+    std::unordered_map<uint64_t, std::vector<size_t>> fromByShape;
+    for (size_t i = diff.fromObjects.size(); i-- > 0;) {
+        if (!fromMatched[i]) {
+            fromByShape[diff.fromObjects[i].shape].push_back(i);
+        }
+    }
+    for (auto i : unmatchedByKey) {
+        auto it = fromByShape.find(diff.toObjects[i].shape);
+        if (it != fromByShape.end() && !it->second.empty()) {
+            fromMatched[it->second.back()] = true;
+            diff.modified.push_back({ .from = it->second.back(), .to = i });
+            it->second.pop_back();
+        }
+        else {
+            diff.added.push_back(i);
+        }
+    }
+    for (size_t i = 0; i < diff.fromObjects.size(); i += 1) {
+        if (!fromMatched[i]) {
+            diff.removed.push_back(i);
+        }
+    }
+    return diff;
+}
+
+Result<std::string> be::decompressLevelString(gd::string const& level) {
+    if (!std::string_view(level).starts_with(COMPRESSED_PREFIX)) {
+        return Ok(std::string(level));
+    }
+    std::string data = ZipUtils::decompressString(level, false, 0);
+    if (data.empty()) {
+        return Err("Unable to decompress level string");
+    }
+    return Ok(std::move(data));
+}
+std::vector<ObjectRecord> be::parseLevelObjects(std::string_view level) {
+    std::vector<ObjectRecord> objects;
+    parseLevel(level, objects);
+    return objects;
+}
+std::string_view be::getLevelSettings(std::string_view level) {
+    return level.substr(0, level.find(';'));
+}
+std::vector<std::pair<std::string_view, std::string_view>> be::parseLevelSettings(std::string_view settings) {
+    std::vector<std::pair<std::string_view, std::string_view>> pairs;
+    forEachPair(settings, [&](std::string_view key, std::string_view value) {
+        pairs.emplace_back(key, value);
+    });
+    return pairs;
+}
+
+Result<be::LevelDiff> be::LevelDiff::computeForLevels(gd::string const& from, gd::string const& to) {
+    GEODE_UNWRAP_INTO(auto fromData, decompressLevelString(from));
+    GEODE_UNWRAP_INTO(auto toData, decompressLevelString(to));
+    return Ok(compute(fromData, toData));
+}
+
+bool be::LevelDiff::empty() const {
+    return added.empty() && removed.empty() && modified.empty() && changedSettings.empty();
+}
+std::vector<size_t> be::LevelDiff::getChangedFromIndices() const {
+    std::vector<size_t> indices = removed;
+    for (auto const& mod : modified) {
+        indices.push_back(mod.from);
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <string_view>
+#include <vector>
+
+using namespace geode::prelude;
+
+namespace be {
+    /**
+     * The object-level differences between two level strings. Objects are 
+     * matched by the hash of their whole property string first, so unchanged 
+     * objects are found without comparing any properties. The rest are 
+     * matched by their ID and position, which makes an object with some 
+     * other property changed count as modified. What's left is matched by 
+     * every property except the position, so a moved object counts as 
+     * modified too. Only an object that was both moved and otherwise changed 
+     * counts as removed and added again
+     */
+    struct LevelDiff final {
+        struct ObjectRecord final {
+            int objectID;
+            float x;
+            float y;
+            // Hash of the whole object string
+            uint64_t hash;
+            // Hash of the ID and position
+            uint64_t key;
+            // Hash of every property except the position
+            uint64_t shape;
+            // Where the object is in its level string
+            size_t offset;
+            size_t length;
+        };
+        struct Match final {
+            size_t from;
+            size_t to;
+        };
+
+        // Every object in each level string, in the order they appear in it
+        std::vector<ObjectRecord> fromObjects;
+        std::vector<ObjectRecord> toObjects;
+
+        // Indices into `toObjects`
+        std::vector<size_t> added;
+        // Indices into `fromObjects`
+        std::vector<size_t> removed;
+        std::vector<Match> modified;
+        std::vector<Match> unchanged;
+        // Keys of the level settings (like `kA13`) that differ
+        std::vector<std::string> changedSettings;
+
+        /**
+         * Diff two uncompressed level strings
+         */
+        static LevelDiff compute(std::string_view from, std::string_view to);
+        /**
+         * Diff two level strings as saved in a level, decompressing them first 
+         * if needed
+         */
+        static Result<LevelDiff> computeForLevels(gd::string const& from, gd::string const& to);
+
+        bool empty() const;
+        /**
+         * Indices into `fromObjects` of every object that isn't in `to` as-is
+         */
+        std::vector<size_t> getChangedFromIndices() const;
+    };
+
+    /**
+     * Decompress a level string as saved in a level, or copy it as-is if it 
+     * isn't compressed
+     */
+    Result<std::string> decompressLevelString(gd::string const& level);
+    /**
+     * Parse every object in an uncompressed level string, in order
+     */
+    std::vector<LevelDiff::ObjectRecord> parseLevelObjects(std::string_view level);
+    /**
+     * Get the level settings part of an uncompressed level string
+     */
+    std::string_view getLevelSettings(std::string_view level);
+    /**
+     * Split level settings into their key-value pairs, in order
+     */
+    std::vector<std::pair<std::string_view, std::string_view>> parseLevelSettings(std::string_view settings);
+}
@@ -0,0 +1,189 @@
+#include "LevelMerge.hpp"
+#include "LevelDiff.hpp"
+#include <unordered_map>
+#include <unordered_set>
+
+static constexpr size_t NO_MATCH = static_cast<size_t>(-1);
+
+using be::LevelDiff;
+
+// How each object in the common ancestor ended up on one side
+struct SideMatches final {
+    // Index of the matching object on that side, or `NO_MATCH` if removed
+    std::vector<size_t> baseToSide;
+    std::vector<bool> modified;
+    // Index of the matching object in the ancestor for every object on that 
+    // side, or `NO_MATCH` if added
+    std::vector<size_t> sideToBase;
+
+    SideMatches(LevelDiff const& diff)
+      : baseToSide(diff.fromObjects.size(), NO_MATCH),
+        modified(diff.fromObjects.size(), false),
+        sideToBase(diff.toObjects.size(), NO_MATCH)
+    {
+        for (auto const& match : diff.unchanged) {
+            baseToSide[match.from] = match.to;
+            sideToBase[match.to] = match.from;
+        }
+        for (auto const& match : diff.modified) {
+            baseToSide[match.from] = match.to;
+            sideToBase[match.to] = match.from;
+            modified[match.from] = true;
+        }
+    }
+};
+
+static std::string mergeSettings(
+    std::string_view base, std::string_view ours, std::string_view theirs,
+    std::vector<std::string>& conflicts
+) {
+    std::unordered_map<std::string_view, std::string_view> baseSettings;
+    for (auto const& [key, value] : be::parseLevelSettings(base)) {
+        baseSettings.emplace(key, value);
+    }
+    const auto theirsPairs = be::parseLevelSettings(theirs);
+    std::unordered_map<std::string_view, std::string_view> theirsSettings;
+    for (auto const& [key, value] : theirsPairs) {
+        theirsSettings.emplace(key, value);
+    }
+
+    std::string out;
+    auto append = [&](std::string_view key, std::string_view value) {
+        if (!out.empty()) out.push_back(',');
+        out.append(key);
+        out.push_back(',');
+        out.append(value);
+    };
+
+    std::unordered_set<std::string_view> seen;
+    for (auto const& [key, value] : be::parseLevelSettings(ours)) {
+        seen.insert(key);
+        auto baseIt = baseSettings.find(key);
+        auto theirsIt = theirsSettings.find(key);
+        const bool oursChanged = baseIt == baseSettings.end() || baseIt->second != value;
+        if (!oursChanged) {
+            // Take theirs, or leave the setting out if they removed it
+            if (theirsIt != theirsSettings.end()) {
+                append(key, theirsIt->second);
+            }
+            continue;
+        }
+        const bool theirsChanged = baseIt == baseSettings.end() ?
+            theirsIt != theirsSettings.end() :
+            theirsIt == theirsSettings.end() || theirsIt->second != baseIt->second;
+        const bool sameChange = theirsIt != theirsSettings.end() && theirsIt->second == value;
+        if (theirsChanged && !sameChange) {
+            conflicts.emplace_back(key);
+        }
+        append(key, value);
+    }
+    for (auto const& [key, value] : theirsPairs) {
+        if (seen.contains(key)) {
+            continue;
+        }
+        auto baseIt = baseSettings.find(key);
+        // Removed on our side and untouched on theirs
+        if (baseIt != baseSettings.end() && baseIt->second == value) {
+            continue;
+        }
+        if (baseIt != baseSettings.end()) {
+            conflicts.emplace_back(key);
+        }
+        append(key, value);
+    }
+    return out;
+}
+
+be::LevelMerge be::LevelMerge::compute(std::string_view base, std::string_view ours, std::string_view theirs) {
+    const auto oursDiff = LevelDiff::compute(base, ours);
+    const auto theirsDiff = LevelDiff::compute(base, theirs);
+    const auto oursMatches = SideMatches(oursDiff);
+    const auto theirsMatches = SideMatches(theirsDiff);
+
+    auto merge = LevelMerge();
+    merge.oursChanges = oursDiff.added.size() + oursDiff.removed.size() + oursDiff.modified.size();
+    merge.theirsChanges = theirsDiff.added.size() + theirsDiff.removed.size() + theirsDiff.modified.size();
+
+    merge.levelString = mergeSettings(
+        getLevelSettings(base), getLevelSettings(ours), getLevelSettings(theirs),
+        merge.conflictingSettings
+    );
+    merge.levelString.push_back(';');
+    merge.levelString.reserve(ours.size() + ours.size() / 8);
+    merge.objectIDs.reserve(oursDiff.toObjects.size());
+
+    auto emit = [&](std::string_view level, LevelDiff::ObjectRecord const& record, bool conflict) {
+        if (conflict) {
+            merge.conflicts.push_back(merge.objectIDs.size());
+        }
+        merge.objectIDs.push_back(record.objectID);
+        merge.levelString.append(level.substr(record.offset, record.length));
+        merge.levelString.push_back(';');
+    };
+
+    // Our objects go first and in our order, so the merged level stays as 
+    // close to the current one as possible
+    for (size_t i = 0; i < oursDiff.toObjects.size(); i += 1) {
+        auto const& ourObject = oursDiff.toObjects[i];
+        const auto baseIndex = oursMatches.sideToBase[i];
+        if (baseIndex == NO_MATCH) {
+            emit(ours, ourObject, false);
+            continue;
+        }
+        const auto theirsIndex = theirsMatches.baseToSide[baseIndex];
+        const bool oursModified = oursMatches.modified[baseIndex];
+        const bool theirsModified = theirsIndex != NO_MATCH && theirsMatches.modified[baseIndex];
+
+        // Deleted on their side
+        if (theirsIndex == NO_MATCH) {
+            if (oursModified) {
+                emit(ours, ourObject, true);
+            }
+            continue;
+        }
+        auto const& theirObject = theirsDiff.toObjects[theirsIndex];
+        if (!theirsModified || theirObject.hash == ourObject.hash) {
+            emit(ours, ourObject, false);
+        }
+        else if (!oursModified) {
+            emit(theirs, theirObject, false);
+        }
+        else {
+            emit(ours, ourObject, true);
+            emit(theirs, theirObject, true);
+        }
+    }
+
+    // Objects we deleted but they changed
+    for (auto baseIndex : oursDiff.removed) {
+        const auto theirsIndex = theirsMatches.baseToSide[baseIndex];
+        if (theirsIndex != NO_MATCH && theirsMatches.modified[baseIndex]) {
+            emit(theirs, theirsDiff.toObjects[theirsIndex], true);
+        }
+    }
+
+    // Objects they added, except for ones we added as well
+    std::unordered_map<uint64_t, size_t> oursAdded;
+    for (auto i : oursDiff.added) {
+        oursAdded[oursDiff.toObjects[i].hash] += 1;
+    }
+    for (auto i : theirsDiff.added) {
+        auto const& object = theirsDiff.toObjects[i];
+        if (auto it = oursAdded.find(object.hash); it != oursAdded.end() && it->second > 0) {
+            it->second -= 1;
+            continue;
+        }
+        emit(theirs, object, false);
+    }
+
+    return merge;
+}
+
+Result<be::LevelMerge> be::LevelMerge::computeForLevels(
+    gd::string const& base, gd::string const& ours, gd::string const& theirs
+) {
+    GEODE_UNWRAP_INTO(auto baseData, decompressLevelString(base));
+    GEODE_UNWRAP_INTO(auto oursData, decompressLevelString(ours));
+    GEODE_UNWRAP_INTO(auto theirsData, decompressLevelString(theirs));
+    return Ok(compute(baseData, oursData, theirsData));
+}
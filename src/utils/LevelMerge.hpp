@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <string_view>
+#include <vector>
+
+using namespace geode::prelude;
+
+namespace be {
+    /**
+     * A three-way merge of two levels that were both edited from a common 
+     * ancestor. Objects are matched to the ancestor the same way as in 
+     * `LevelDiff`, so moving an object counts as changing it. A change made 
+     * on only one side is always taken. If both sides changed the same 
+     * object differently (including moving it to different places), or one 
+     * side deleted an object the other one changed, the object is a 
+     * conflict: every changed version of it is kept so the conflict can be 
+     * resolved in the editor
+     */
+    struct LevelMerge final {
+        // The merged level string, uncompressed
+        std::string levelString;
+        // IDs of every object in the merged level string, in order
+        std::vector<int> objectIDs;
+        // Indices of conflicting objects in the merged level string
+        std::vector<size_t> conflicts;
+        // Level settings changed differently on both sides. Ours are kept
+        std::vector<std::string> conflictingSettings;
+        // How many objects were added, removed or changed on each side
+        size_t oursChanges = 0;
+        size_t theirsChanges = 0;
+
+        /**
+         * Merge two uncompressed level strings
+         */
+        static LevelMerge compute(std::string_view base, std::string_view ours, std::string_view theirs);
+        /**
+         * Merge two level strings as saved in a level, decompressing them first 
+         * if needed
+         */
+        static Result<LevelMerge> computeForLevels(
+            gd::string const& base, gd::string const& ours, gd::string const& theirs
+        );
+    };
+}
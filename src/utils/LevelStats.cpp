@@ -0,0 +1,259 @@
+#include "LevelStats.hpp"
+#include "GroupIndex.hpp"
+#include "ObjectIDs.hpp"
+#include <Geode/modify/LevelEditorLayer.hpp>
+#include <Geode/modify/EditorUI.hpp>
+#include <Geode/utils/cocos.hpp>
+
+class $modify(LevelStatsLayer, LevelEditorLayer) {
+    struct Fields {
+        be::LevelStats stats;
+    };
+
+    $override
+    bool init(GJGameLevel* level, bool p1) {
+        if (!LevelEditorLayer::init(level, p1))
+            return false;
+
+        // All of the level's objects have been loaded in by now
+        m_fields->stats.rebuild(this);
+
+        return true;
+    }
+
+    $override
+    GameObject* createObject(int id, CCPoint pos, bool p2) {
+        auto obj = LevelEditorLayer::createObject(id, pos, p2);
+        if (obj) {
+            m_fields->stats.addObject(obj);
+        }
+        return obj;
+    }
+    $override
+    CCArray* createObjectsFromString(gd::string const& str, bool p1, bool p2) {
+        auto objs = LevelEditorLayer::createObjectsFromString(str, p1, p2);
+        if (objs) {
+            for (auto obj : CCArrayExt<GameObject*>(objs)) {
+                m_fields->stats.addObject(obj);
+            }
+        }
+        return objs;
+    }
+    $override
+    void removeObject(GameObject* obj, bool p1) {
+        m_fields->stats.removeObject(obj);
+        LevelEditorLayer::removeObject(obj, p1);
+    }
+};
+
+static be::LevelStats* getStats(LevelEditorLayer* lel) {
+    return &static_cast<LevelStatsLayer*>(lel)->m_fields->stats;
+}
+
+// Objects can only be edited while they are selected
+class $modify(EditorUI) {
+    $override
+    void selectObject(GameObject* obj, bool filter) {
+        if (obj) {
+            getStats(m_editorLayer)->markDirty(obj);
+        }
+        EditorUI::selectObject(obj, filter);
+    }
+    $override
+    void selectObjects(CCArray* objs, bool ignoreFilters) {
+        if (objs) {
+            for (auto obj : CCArrayExt<GameObject*>(objs)) {
+                getStats(m_editorLayer)->markDirty(obj);
+            }
+        }
+        EditorUI::selectObjects(objs, ignoreFilters);
+    }
+    $override
+    void deselectObject(GameObject* obj) {
+        if (obj) {
+            getStats(m_editorLayer)->markDirty(obj);
+        }
+        EditorUI::deselectObject(obj);
+    }
+    $override
+    void deselectAll() {
+        auto stats = getStats(m_editorLayer);
+        if (m_selectedObject) {
+            stats->markDirty(m_selectedObject);
+        }
+        for (auto obj : CCArrayExt<GameObject*>(m_selectedObjects)) {
+            stats->markDirty(obj);
+        }
+        EditorUI::deselectAll();
+    }
+};
+
+static void adjustCount(be::LevelStats::Counts& counts, int key, bool add) {
+    if (add) {
+        counts[key] += 1;
+    }
+    else if (auto it = counts.find(key); it != counts.end() && --it->second == 0) {
+        counts.erase(it);
+    }
+}
+
+be::LevelStats* be::LevelStats::get() {
+    auto lel = LevelEditorLayer::get();
+    if (!lel) {
+        return nullptr;
+    }
+    auto stats = getStats(lel);
+    // Not ready until the editor has finished loading
+    if (!stats->m_editor) {
+        return nullptr;
+    }
+    stats->refresh();
+    return stats;
+}
+
+be::LevelStats::ObjectRecord be::LevelStats::createRecord(GameObject* obj) {
+    auto record = ObjectRecord {
+        .objectID = obj->m_objectID,
+        .highDetail = obj->m_isHighDetail,
+        .layers = { obj->m_editorLayer, obj->m_editorLayer2 },
+        .colors = {
+            obj->m_baseColor ? obj->m_baseColor->m_colorID : -1,
+            obj->m_detailColor ? obj->m_detailColor->m_colorID : -1,
+        },
+    };
+    // Only count the same layer or color once per object
+    if (record.layers[1] == record.layers[0]) {
+        record.layers[1] = 0;
+    }
+    if (record.colors[1] == record.colors[0]) {
+        record.colors[1] = -1;
+    }
+    return record;
+}
+void be::LevelStats::count(ObjectRecord const& record, bool add) {
+    m_objectCount = add ? m_objectCount + 1 : m_objectCount - 1;
+    m_highDetailCount = add ? m_highDetailCount + record.highDetail : m_highDetailCount - record.highDetail;
+    adjustCount(m_objectsByID, record.objectID, add);
+    adjustCount(m_objectsByLayer, record.layers[0], add);
+    if (record.layers[1] != 0) {
+        adjustCount(m_objectsByLayer, record.layers[1], add);
+    }
+    for (auto color : record.colors) {
+        if (color != -1) {
+            adjustCount(m_objectsByColor, color, add);
+        }
+    }
+    if (object_ids::isTriggerID(record.objectID)) {
+        m_triggerCount = add ? m_triggerCount + 1 : m_triggerCount - 1;
+        adjustCount(m_triggersByID, record.objectID, add);
+    }
+}
+
+void be::LevelStats::rebuild(LevelEditorLayer* editor) {
+    m_editor = editor;
+    m_objectCount = 0;
+    m_highDetailCount = 0;
+    m_triggerCount = 0;
+    m_objectsByID.clear();
+    m_objectsByLayer.clear();
+    m_objectsByColor.clear();
+    m_triggersByID.clear();
+    m_dirty.clear();
+
+    for (auto obj : CCArrayExt<GameObject*>(m_editor->m_objects)) {
+        this->count(createRecord(obj), true);
+    }
+    // Whatever is selected may still be edited
+    if (auto ui = m_editor->m_editorUI) {
+        if (ui->m_selectedObject) {
+            this->markDirty(ui->m_selectedObject);
+        }
+        for (auto obj : CCArrayExt<GameObject*>(ui->m_selectedObjects)) {
+            this->markDirty(obj);
+        }
+    }
+}
+void be::LevelStats::addObject(GameObject* obj) {
+    // Everything gets counted at once after the level has loaded
+    if (!m_editor) {
+        return;
+    }
+    this->count(createRecord(obj), true);
+}
+void be::LevelStats::removeObject(GameObject* obj) {
+    if (!m_editor) {
+        return;
+    }
+    // Uncount the object the way it was counted, which may be different from 
+    // how it is now if it has been edited
+    if (auto it = m_dirty.find(obj); it != m_dirty.end()) {
+        this->count(it->second, false);
+        m_dirty.erase(it);
+    }
+    else {
+        this->count(createRecord(obj), false);
+    }
+}
+void be::LevelStats::markDirty(GameObject* obj) {
+    if (!m_editor) {
+        return;
+    }
+    // If the object was already dirty then the record from back then is what 
+    // it's still counted as
+    m_dirty.try_emplace(obj, createRecord(obj));
+}
+void be::LevelStats::refresh() {
+    // Undoing and redoing deletions doesn't go through the hooks above, so 
+    // if the counts have drifted just start over
+    if (m_objectCount != m_editor->m_objects->count()) {
+        this->rebuild(m_editor);
+    }
+    for (auto it = m_dirty.begin(); it != m_dirty.end();) {
+        const auto record = createRecord(it->first);
+        if (record != it->second) {
+            this->count(it->second, false);
+            this->count(record, true);
+            it->second = record;
+        }
+        // Objects that are still selected may still be edited
+        if (it->first->m_isSelected) {
+            ++it;
+        }
+        else {
+            it = m_dirty.erase(it);
+        }
+    }
+}
+
+size_t be::LevelStats::getObjectCount() const {
+    return m_objectCount;
+}
+size_t be::LevelStats::getHighDetailCount() const {
+    return m_highDetailCount;
+}
+size_t be::LevelStats::getTriggerCount() const {
+    return m_triggerCount;
+}
+be::LevelStats::Counts const& be::LevelStats::getObjectsByID() const {
+    return m_objectsByID;
+}
+be::LevelStats::Counts const& be::LevelStats::getObjectsByLayer() const {
+    return m_objectsByLayer;
+}
+be::LevelStats::Counts const& be::LevelStats::getObjectsByColor() const {
+    return m_objectsByColor;
+}
+be::LevelStats::Counts const& be::LevelStats::getTriggersByID() const {
+    return m_triggersByID;
+}
+be::LevelStats::Counts be::LevelStats::getObjectsByGroup() const {
+    Counts counts;
+    if (auto index = GroupIndex::get()) {
+        for (int group = 1; group <= GroupIndex::MAX_GROUP_ID; group += 1) {
+            if (auto count = index->getObjectCountInGroup(group)) {
+                counts[group] = count;
+            }
+        }
+    }
+    return counts;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Geode/binding/LevelEditorLayer.hpp>
+#include <Geode/binding/GameObject.hpp>
+
+using namespace geode::prelude;
+
+namespace be {
+    /**
+     * Running counts of what the level in the current editor consists of.
+     * Objects created and deleted through the editor are counted right away.
+     * The properties of existing objects get edited directly by too many
+     * different popups to hook them all, but objects have to be selected to
+     * be edited, so only objects that are or were selected since the stats
+     * were last read are checked again. Per-group counts come from
+     * `GroupIndex`
+     */
+    class LevelStats final {
+    public:
+        using Counts = std::unordered_map<int, size_t>;
+
+    protected:
+        struct ObjectRecord final {
+            int objectID;
+            bool highDetail;
+            // The second layer is 0 if the object only has one layer
+            std::array<int, 2> layers;
+            std::array<int, 2> colors;
+
+            bool operator==(ObjectRecord const&) const = default;
+        };
+
+        LevelEditorLayer* m_editor = nullptr;
+        size_t m_objectCount = 0;
+        size_t m_highDetailCount = 0;
+        size_t m_triggerCount = 0;
+        Counts m_objectsByID;
+        Counts m_objectsByLayer;
+        Counts m_objectsByColor;
+        Counts m_triggersByID;
+        // Objects that may have been edited, and how they were counted
+        std::unordered_map<GameObject*, ObjectRecord> m_dirty;
+
+        static ObjectRecord createRecord(GameObject* obj);
+        void count(ObjectRecord const& record, bool add);
+        /**
+         * Recount the objects that may have been edited, or everything if
+         * objects have been added or removed in some way that wasn't counted
+         */
+        void refresh();
+
+    public:
+        /**
+         * Get the stats for the current editor, or null if not in the editor
+         */
+        static LevelStats* get();
+
+        /**
+         * Recount everything from scratch
+         */
+        void rebuild(LevelEditorLayer* editor);
+        void addObject(GameObject* obj);
+        void removeObject(GameObject* obj);
+        /**
+         * Check the object's properties again the next time the stats are
+         * read
+         */
+        void markDirty(GameObject* obj);
+
+        size_t getObjectCount() const;
+        size_t getHighDetailCount() const;
+        size_t getTriggerCount() const;
+        Counts const& getObjectsByID() const;
+        Counts const& getObjectsByLayer() const;
+        Counts const& getObjectsByColor() const;
+        Counts const& getTriggersByID() const;
+        Counts getObjectsByGroup() const;
+    };
+}
@@ -7,17 +7,10 @@
 #include <Geode/utils/cocos.hpp>
 #include <Geode/ui/TextInput.hpp>
 #include <span>
+#include "UsedIDs.hpp"
 
 using namespace geode::prelude;
 
-template <class C>
-concept NextFreeSource = requires {
-    typename C::ValueType;
-    { C::getUsedIDs(std::declval<GameObject*>(), std::declval<std::unordered_set<typename C::ValueType>&>()) } -> std::same_as<void>;
-    { C::MIN_VALUE } -> std::convertible_to<typename C::ValueType>;
-    { C::MAX_VALUE } -> std::convertible_to<typename C::ValueType>;
-};
-
 // Nån kanske vill veta varför några kommentarer här är på svenska.
 // Det är eftersom jag har en svenskkurs just nu och ville använda denna möjligheten 
 // för att öva mig datavetenskaps vokabulär och att tala detta språket allmänt
@@ -75,14 +68,14 @@ public:
     }
 
     static ValueType getNextFreeID() {
-        std::unordered_set<ValueType> used;
-        for (auto obj : CCArrayExt<GameObject*>(LevelEditorLayer::get()->m_objects)) {
-            Source::getUsedIDs(obj, used);
+        if constexpr (IndexedNextFreeSource<Source>) {
+            if (auto used = Source::getUsedIDIndex()) {
+                return static_cast<ValueType>(used->findNextFree(s_value));
+            }
         }
-        auto next = s_value;
-        while (next != Source::MAX_VALUE && used.contains(next)) {
-            next += 1;
+        if (auto lel = LevelEditorLayer::get()) {
+            return static_cast<ValueType>(be::collectUsedIDs<Source>(lel).findNextFree(s_value));
         }
-        return next;
+        return s_value;
     }
 };
@@ -5,6 +5,7 @@
 using namespace geode::prelude;
 
 namespace object_ids {
+    static constexpr int COLOR_TRIGGER = 899;
     static constexpr int MOVE_TRIGGER = 901;
     static constexpr int STOP_TRIGGER = 1616;
     static constexpr int PULSE_TRIGGER = 1006;
@@ -56,6 +57,7 @@ namespace object_ids {
     static constexpr int INSTANT_COLLISION_TRIGGER = 3609;
     static constexpr int ON_DEATH_TRIGGER = 1812;
     static constexpr int PLAYER_CONTROL_TRIGGER = 1932;
+    static constexpr int ITEM_EDIT_TRIGGER = 3619;
 
     static constexpr bool isTriggerID(int id) {
         switch (id) {
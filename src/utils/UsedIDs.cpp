@@ -0,0 +1,53 @@
+#include "UsedIDs.hpp"
+#include <bit>
+
+be::UsedIDBitset::UsedIDBitset(int min, int max)
+  : m_min(min), m_max(max),
+    m_refCounts(max - min + 1, 0),
+    m_words((max - min + 1 + 63) / 64, 0)
+{}
+
+void be::UsedIDBitset::add(int id, uint32_t count) {
+    if (id < m_min || id > m_max || count == 0) {
+        return;
+    }
+    const auto ix = id - m_min;
+    m_refCounts[ix] += count;
+    m_words[ix / 64] |= uint64_t(1) << (ix % 64);
+}
+void be::UsedIDBitset::remove(int id, uint32_t count) {
+    if (id < m_min || id > m_max || count == 0) {
+        return;
+    }
+    const auto ix = id - m_min;
+    m_refCounts[ix] -= std::min(m_refCounts[ix], count);
+    if (m_refCounts[ix] == 0) {
+        m_words[ix / 64] &= ~(uint64_t(1) << (ix % 64));
+    }
+}
+void be::UsedIDBitset::clear() {
+    std::fill(m_refCounts.begin(), m_refCounts.end(), 0);
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+bool be::UsedIDBitset::isUsed(int id) const {
+    if (id < m_min || id > m_max) {
+        return false;
+    }
+    const auto ix = id - m_min;
+    return m_words[ix / 64] & (uint64_t(1) << (ix % 64));
+}
+int be::UsedIDBitset::findNextFree(int from) const {
+    const auto start = std::clamp(from, m_min, m_max) - m_min;
+    auto word = static_cast<size_t>(start / 64);
+    // Ignore the IDs before `start` in the first word
+    auto free = ~m_words[word] & (~uint64_t(0) << (start % 64));
+    while (free == 0) {
+        word += 1;
+        if (word >= m_words.size()) {
+            return m_max;
+        }
+        free = ~m_words[word];
+    }
+    return std::min(m_min + static_cast<int>(word * 64) + std::countr_zero(free), m_max);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Geode/binding/GameObject.hpp>
+#include <Geode/binding/LevelEditorLayer.hpp>
+#include <Geode/utils/cocos.hpp>
+
+using namespace geode::prelude;
+
+namespace be {
+    /**
+     * Reference-counted set of used IDs in the range `[min, max]`. IDs
+     * outside of the range are ignored
+     */
+    class UsedIDBitset final {
+    protected:
+        int m_min;
+        int m_max;
+        std::vector<uint32_t> m_refCounts;
+        std::vector<uint64_t> m_words;
+
+    public:
+        UsedIDBitset(int min, int max);
+
+        void add(int id, uint32_t count = 1);
+        void remove(int id, uint32_t count = 1);
+        void clear();
+
+        bool isUsed(int id) const;
+        /**
+         * Find the first unused ID starting from `from`, or the max ID if
+         * every ID after `from` is used
+         */
+        int findNextFree(int from) const;
+    };
+}
+
+template <class C>
+concept NextFreeSource = requires {
+    typename C::ValueType;
+    { C::getUsedIDs(std::declval<GameObject*>(), std::declval<std::vector<typename C::ValueType>&>()) } -> std::same_as<void>;
+    { C::MIN_VALUE } -> std::convertible_to<typename C::ValueType>;
+    { C::MAX_VALUE } -> std::convertible_to<typename C::ValueType>;
+};
+
+// Sources that keep their own index of used IDs up to date, so nothing has to
+// go through every object. The index may be null if it isn't available
+template <class C>
+concept IndexedNextFreeSource = NextFreeSource<C> && requires {
+    { C::getUsedIDIndex() } -> std::same_as<be::UsedIDBitset const*>;
+};
+
+namespace be {
+    /**
+     * Collect the IDs of a `NextFreeSource` that are used by any object in
+     * the editor. This goes through every object, so it's meant for one-off
+     * queries like clicking a next free button
+     */
+    template <NextFreeSource Source>
+    UsedIDBitset collectUsedIDs(LevelEditorLayer* editor) {
+        UsedIDBitset used { Source::MIN_VALUE, Source::MAX_VALUE };
+        std::vector<typename Source::ValueType> ids;
+        for (auto obj : CCArrayExt<GameObject*>(editor->m_objects)) {
+            ids.clear();
+            Source::getUsedIDs(obj, ids);
+            for (auto id : ids) {
+                used.add(id);
+            }
+        }
+        return used;
+    }
+}
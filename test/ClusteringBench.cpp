@@ -0,0 +1,144 @@
+#include <features/TriggerIndicators/Clustering.hpp>
+#include <Geode/utils/ranges.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+// The O(n²) clustering that the grid in Clustering.cpp replaced, kept verbatim
+// so the two can be compared
+static void referenceCluster(std::vector<Cluster>& clustered) {
+    constexpr float MINIMUM_DISTANCE = 10 * 10; // 1/3 of a block
+    for (size_t i = 0; i < clustered.size(); i += 1) {
+        auto& cluster = clustered[i];
+        if (cluster.merged) continue;
+        for (size_t j = 0; j < clustered.size(); j += 1) {
+            if (i == j) continue;
+            auto& uncluster = clustered[j];
+            if (uncluster.merged) continue;
+            if (getDistanceBetweenRectsSq(cluster.rect, uncluster.rect) < MINIMUM_DISTANCE) {
+                const auto diffMinX = uncluster.rect.getMinX() - cluster.rect.getMinX();
+                if (diffMinX < 0.f) {
+                    cluster.rect.origin.x += diffMinX;
+                    cluster.rect.size.width -= diffMinX;
+                }
+                const auto diffMinY = uncluster.rect.getMinY() - cluster.rect.getMinY();
+                if (diffMinY < 0.f) {
+                    cluster.rect.origin.y += diffMinY;
+                    cluster.rect.size.height -= diffMinY;
+                }
+                cluster.rect.size.width += std::max(0.f, uncluster.rect.getMaxX() - cluster.rect.getMaxX());
+                cluster.rect.size.height += std::max(0.f, uncluster.rect.getMaxY() - cluster.rect.getMaxY());
+                cluster.selected |= uncluster.selected;
+                cluster.objects += 1;
+                uncluster.merged = true;
+            }
+        }
+    }
+    // Remove all merged clusters from the result
+    ranges::remove(clustered, [](Cluster const& cluster) { return cluster.merged; });
+}
+
+// Deco-heavy levels are mostly lots of small objects packed into a few
+// areas, with some bigger ones and the odd stray far away from everything
+static std::vector<Cluster> generatePacked(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> areaPos(0, 30 * 2000);
+    std::uniform_real_distribution<float> spread(-300, 300);
+    std::uniform_real_distribution<float> smallSize(2, 30);
+    std::uniform_real_distribution<float> bigSize(30, 240);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<CCPoint> areas;
+    for (size_t i = 0; i < count / 500 + 1; i += 1) {
+        areas.push_back(ccp(areaPos(rng), areaPos(rng) / 20));
+    }
+    std::uniform_int_distribution<size_t> pickArea(0, areas.size() - 1);
+
+    std::vector<Cluster> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i += 1) {
+        const auto roll = percent(rng);
+        CCPoint pos;
+        if (roll < 5) {
+            pos = ccp(areaPos(rng), areaPos(rng) / 20);
+        }
+        else {
+            pos = areas[pickArea(rng)] + ccp(spread(rng), spread(rng));
+        }
+        const auto size = roll >= 95 ? bigSize(rng) : smallSize(rng);
+        result.push_back(Cluster {
+            .rect = CCRect(pos.x - size / 2, pos.y - size / 2, size, size * (roll % 2 ? 1.f : .5f)),
+            .selected = roll == 42,
+        });
+    }
+    return result;
+}
+
+// Objects spread evenly along the level, which is the worst case for the old
+// implementation since hardly anything gets merged
+static std::vector<Cluster> generateSpread(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> row(0, 20);
+    std::uniform_real_distribution<float> size(5, 15);
+
+    std::vector<Cluster> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i += 1) {
+        const auto s = size(rng);
+        result.push_back(Cluster {
+            .rect = CCRect(static_cast<float>(i / 20) * 60, static_cast<float>(row(rng)) * 60, s, s),
+            .selected = false,
+        });
+    }
+    return result;
+}
+
+static bool sameClusters(std::vector<Cluster> const& a, std::vector<Cluster> const& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i += 1) {
+        if (
+            !a[i].rect.equals(b[i].rect) ||
+            a[i].selected != b[i].selected ||
+            a[i].objects != b[i].objects
+        ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class F>
+static double timeMs(F&& fun) {
+    const auto start = std::chrono::steady_clock::now();
+    fun();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    bool ok = true;
+    std::printf("%8s %8s %10s %12s %12s %9s\n", "layout", "rects", "clusters", "old (ms)", "grid (ms)", "speedup");
+    for (auto [name, generate] : {
+        std::pair("packed", &generatePacked),
+        std::pair("spread", &generateSpread),
+    }) {
+        for (size_t count : { 1000, 10000, 50000 }) {
+            const auto targets = generate(count, static_cast<uint32_t>(count));
+            auto expected = targets;
+            auto actual = targets;
+            const auto oldMs = timeMs([&] { referenceCluster(expected); });
+            const auto gridMs = timeMs([&] { cluster(actual); });
+
+            std::printf(
+                "%8s %8zu %10zu %12.2f %12.2f %8.1fx\n",
+                name, count, actual.size(), oldMs, gridMs, oldMs / std::max(gridMs, 0.001)
+            );
+            if (!sameClusters(expected, actual)) {
+                std::printf("  mismatch: expected %zu clusters, got %zu\n", expected.size(), actual.size());
+                ok = false;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
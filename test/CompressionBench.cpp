@@ -0,0 +1,57 @@
+#include "LevelStrings.hpp"
+#include <utils/Compression.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+template <class F>
+static double timeMs(F&& fun) {
+    const auto start = std::chrono::steady_clock::now();
+    fun();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const auto path = std::filesystem::temp_directory_path() / "be-compression-bench";
+    bool ok = true;
+
+    std::printf("%8s %10s %6s %12s %7s %11s %10s\n", "objects", "raw", "level", "written", "ratio", "write (ms)", "read (ms)");
+    for (size_t count : { 10000, 80000, 250000 }) {
+        const auto level = generateLevelString(count, static_cast<uint32_t>(count));
+
+        // What backups did before: the raw string straight to disk
+        const auto plainMs = timeMs([&] {
+            std::ofstream file(path, std::ios::binary);
+            file.write(level.data(), level.size());
+        });
+        std::printf(
+            "%8zu %10zu %6s %12zu %6.1f%% %11.2f %10s\n",
+            count, level.size(), "plain", level.size(), 100.f, plainMs, "-"
+        );
+
+        for (int compression : { 1, 6, 9 }) {
+            Result<> written = Ok();
+            const auto writeMs = timeMs([&] {
+                written = be::writeCompressed(path, level, compression);
+            });
+            std::string read;
+            Result<> readResult = Ok();
+            const auto readMs = timeMs([&] {
+                readResult = be::readCompressed(path, read);
+            });
+            if (!written || !readResult || read != level) {
+                std::printf("  level %d: round trip failed\n", compression);
+                ok = false;
+                continue;
+            }
+            const auto size = std::filesystem::file_size(path);
+            std::printf(
+                "%8zu %10zu %6d %12zu %6.1f%% %11.2f %10.2f\n",
+                count, level.size(), compression, static_cast<size_t>(size),
+                100.f * size / level.size(), writeMs, readMs
+            );
+        }
+    }
+    std::filesystem::remove(path);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#include "LevelStrings.hpp"
+#include <utils/Hash.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+template <class F>
+static double bestOfMs(int runs, F&& fun) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < runs; i += 1) {
+        const auto start = std::chrono::steady_clock::now();
+        fun();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// Hashes are saved to backup metadata, so they must match the reference
+// XXH64 and not just be consistent with themselves
+static bool checkKnownHashes() {
+    struct Known final {
+        std::string_view data;
+        uint64_t hash;
+    };
+    constexpr Known KNOWN[] = {
+        { "", 0xEF46DB3751D8E999ull },
+        { "a", 0xD24EC4F1A98C6E5Bull },
+        { "abc", 0x44BC2CF5AD770999ull },
+    };
+    bool ok = true;
+    for (auto const& known : KNOWN) {
+        if (be::hash64(known.data) != known.hash) {
+            std::printf("hash of \"%.*s\" is wrong\n", static_cast<int>(known.data.size()), known.data.data());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main() {
+    bool ok = checkKnownHashes();
+    volatile uint64_t sink = 0;
+
+    std::printf("%8s %10s %14s %12s %14s %12s\n", "objects", "bytes", "one-shot (ms)", "(GB/s)", "streamed (ms)", "std::hash");
+    for (size_t count : { 80000, 250000, 1000000 }) {
+        const auto level = generateLevelString(count, static_cast<uint32_t>(count));
+        const auto expected = be::hash64(level);
+
+        const auto oneShotMs = bestOfMs(5, [&] {
+            sink = sink + be::hash64(level);
+        });
+
+        // Hasher is also fed in pieces, and the result has to be the same
+        // no matter how the data was split
+        std::mt19937 rng(static_cast<uint32_t>(count));
+        std::uniform_int_distribution<size_t> pieceSize(1, 64 * 1024);
+        uint64_t streamed = 0;
+        const auto streamedMs = bestOfMs(5, [&] {
+            be::Hasher hasher;
+            for (size_t i = 0; i < level.size();) {
+                const auto size = std::min(pieceSize(rng), level.size() - i);
+                hasher.update(std::string_view(level).substr(i, size));
+                i += size;
+            }
+            streamed = hasher.digest();
+        });
+        if (streamed != expected) {
+            std::printf("  %zu objects: streamed hash doesn't match\n", count);
+            ok = false;
+        }
+
+        // For reference, although std::hash differs between platforms so it
+        // can't be saved to disk
+        const auto stdMs = bestOfMs(5, [&] {
+            sink = sink + std::hash<std::string_view>()(level);
+        });
+
+        std::printf(
+            "%8zu %10zu %14.2f %12.2f %14.2f %9.2f ms\n",
+            count, level.size(), oneShotMs, level.size() / oneShotMs / 1e6, streamedMs, stdMs
+        );
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+#include <features/TriggerIndicators/IndicatorLayout.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+// Checks that laying indicators out on IndicatorLayoutWorker gives exactly 
+// the same geometry as running IndicatorLayout synchronously, over a long 
+// series of snapshots that move the view, edit targets, toggle options and 
+// add and remove triggers like someone using the editor would
+
+struct FakeSlot final {
+    uint64_t id;
+    SlotState state;
+    std::vector<TargetSnapshot> targets;
+    bool targetsChanged = true;
+};
+
+class FakeEditor final {
+protected:
+    std::mt19937 m_rng;
+    uint64_t m_nextID = 1;
+    uint32_t m_nextRevision = 1;
+    std::vector<FakeSlot> m_slots;
+    IndicatorLayoutOptions m_options {
+        .showTriggerToTrigger = true,
+        .showTargets = true,
+        .showClusterOutlines = false,
+        .blockyLines = false,
+        .arrowHeads = true,
+    };
+    CCRect m_view = CCRect(0, 0, 570, 320);
+
+    float random(float min, float max) {
+        return std::uniform_real_distribution<float>(min, max)(m_rng);
+    }
+    bool chance(float p) {
+        return random(0, 1) < p;
+    }
+    CCPoint randomPoint() {
+        return ccp(random(0, 3000), random(0, 600));
+    }
+
+    std::vector<TargetSnapshot> randomTargets() {
+        std::vector<TargetSnapshot> targets;
+        const auto center = this->randomPoint();
+        const auto count = std::uniform_int_distribution<int>(0, 60)(m_rng);
+        for (int i = 0; i < count; i += 1) {
+            const auto pos = center + ccp(random(-200, 200), random(-200, 200));
+            const auto isTrigger = chance(.1f);
+            targets.push_back(TargetSnapshot {
+                .rect = CCRect(pos.x, pos.y, random(5, 30), random(5, 30)),
+                .inputSlotPosition = isTrigger ? pos : CCPoint(),
+                .selected = chance(.05f),
+                .isTrigger = isTrigger,
+            });
+        }
+        return targets;
+    }
+    void addSlot() {
+        m_slots.push_back(FakeSlot {
+            .id = m_nextID++,
+            .state = SlotState {
+                .groupID = std::uniform_int_distribution<int>(1, 9999)(m_rng),
+                .groupRevision = m_nextRevision++,
+                .slotPosition = this->randomPoint(),
+                .dashed = chance(.2f),
+                .triggerSelected = chance(.1f),
+                .color = ccc4(255, 0, 255, 255),
+            },
+            .targets = this->randomTargets(),
+        });
+    }
+
+public:
+    FakeEditor(uint32_t seed) : m_rng(seed) {
+        for (int i = 0; i < 80; i += 1) {
+            this->addSlot();
+        }
+    }
+
+    void step() {
+        if (chance(.7f)) {
+            m_view.origin = m_view.origin + ccp(random(-80, 80), random(-20, 20));
+            m_view.origin.x = std::clamp(m_view.origin.x, -200.f, 2800.f);
+            m_view.origin.y = std::clamp(m_view.origin.y, -200.f, 400.f);
+        }
+        if (chance(.05f)) {
+            m_options.showTargets ^= chance(.5f);
+            m_options.showClusterOutlines ^= chance(.5f);
+            m_options.blockyLines ^= chance(.5f);
+            m_options.arrowHeads ^= chance(.5f);
+            m_options.showTriggerToTrigger ^= chance(.5f);
+        }
+        if (chance(.1f)) {
+            this->addSlot();
+        }
+        if (chance(.1f) && !m_slots.empty()) {
+            m_slots.erase(m_slots.begin() + std::uniform_int_distribution<size_t>(0, m_slots.size() - 1)(m_rng));
+        }
+        for (auto& slot : m_slots) {
+            if (chance(.03f)) {
+                slot.state.groupRevision = m_nextRevision++;
+                slot.targets = this->randomTargets();
+                slot.targetsChanged = true;
+            }
+            if (chance(.02f)) {
+                slot.state.triggerSelected ^= true;
+                slot.targetsChanged = true;
+            }
+        }
+    }
+
+    IndicatorSnapshot snapshot(size_t session) {
+        auto snapshot = IndicatorSnapshot {
+            .session = session,
+            .options = m_options,
+            .view = m_view,
+            .slots = {},
+            .nodes = {},
+        };
+        for (auto& slot : m_slots) {
+            const auto triggerVisible = m_view.intersectsRect(CCRect(
+                slot.state.slotPosition.x - 15, slot.state.slotPosition.y - 15, 30, 30
+            ));
+            snapshot.slots.push_back(SlotSnapshot {
+                .id = slot.id,
+                .state = slot.state,
+                .triggerVisible = triggerVisible,
+                .targets = slot.targetsChanged ? std::optional(slot.targets) : std::nullopt,
+            });
+            slot.targetsChanged = false;
+            if (triggerVisible) {
+                snapshot.nodes.push_back(slot.state.slotPosition);
+            }
+        }
+        return snapshot;
+    }
+};
+
+static bool sameVertices(std::vector<IndicatorVertex> const& a, std::vector<IndicatorVertex> const& b) {
+    return std::ranges::equal(a, b, [](IndicatorVertex const& a, IndicatorVertex const& b) {
+        return a.x == b.x && a.y == b.y &&
+            a.color.r == b.color.r && a.color.g == b.color.g &&
+            a.color.b == b.color.b && a.color.a == b.color.a;
+    });
+}
+
+static bool waitUntilIdle(IndicatorLayoutWorker* worker) {
+    const auto start = std::chrono::steady_clock::now();
+    while (!worker->isIdle()) {
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(10)) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+int main() {
+    constexpr size_t STEPS = 2000;
+
+    auto worker = IndicatorLayoutWorker::get();
+    bool ok = true;
+
+    // Two sessions in a row, like closing the editor and opening another
+    for (size_t session = 0; session < 2; session += 1) {
+        FakeEditor editor(static_cast<uint32_t>(session + 1));
+        IndicatorLayout sync;
+        IndicatorGeometry expected;
+        IndicatorGeometry front;
+        size_t rebuilt = 0;
+
+        for (size_t step = 0; step < STEPS; step += 1) {
+            editor.step();
+            auto snapshot = editor.snapshot(session);
+
+            const bool syncChanged = sync.update(snapshot, expected);
+            worker->submit(std::move(snapshot));
+            if (!waitUntilIdle(worker)) {
+                std::printf("session %zu step %zu: worker never finished\n", session, step);
+                return 1;
+            }
+            const bool threadedChanged = worker->swapResult(session, front);
+            rebuilt += syncChanged;
+
+            if (syncChanged != threadedChanged) {
+                std::printf(
+                    "session %zu step %zu: sync %s changed but threaded %s\n",
+                    session, step,
+                    syncChanged ? "" : "not", threadedChanged ? "did" : "didn't"
+                );
+                ok = false;
+            }
+            if (!sameVertices(expected.lines, front.lines) || !sameVertices(expected.triangles, front.triangles)) {
+                std::printf(
+                    "session %zu step %zu: geometry differs (%zu/%zu lines, %zu/%zu triangles)\n",
+                    session, step,
+                    expected.lines.size(), front.lines.size(),
+                    expected.triangles.size(), front.triangles.size()
+                );
+                ok = false;
+            }
+            if (!ok) {
+                return 1;
+            }
+        }
+        std::printf(
+            "session %zu: %zu snapshots, %zu rebuilds, last frame %zu line and %zu triangle vertices\n",
+            session, STEPS, rebuilt, expected.lines.size(), expected.triangles.size()
+        );
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <utils/LevelDiff.hpp>
+#include <utils/LevelMerge.hpp>
+#include <cstdio>
+
+// Checks how LevelDiff and LevelMerge treat moved objects: a move has to
+// count as a change to the same object and not as one object being removed
+// and another one added, or moves on both sides would never conflict
+
+static constexpr std::string_view SETTINGS = "kS38,1_40_2_125_3_255,kA13,0;";
+
+static std::string level(std::initializer_list<std::string_view> objects) {
+    std::string str(SETTINGS);
+    for (auto object : objects) {
+        str.append(object);
+        str.push_back(';');
+    }
+    return str;
+}
+
+// How many times an object string shows up in a level string
+static size_t count(std::string_view level, std::string_view object) {
+    size_t found = 0;
+    for (auto pos = level.find(';'); pos != std::string_view::npos; pos = level.find(';', pos + 1)) {
+        const auto end = level.find(';', pos + 1);
+        if (end != std::string_view::npos && level.substr(pos + 1, end - pos - 1) == object) {
+            found += 1;
+        }
+    }
+    return found;
+}
+
+static bool s_ok = true;
+static void check(bool cond, const char* what) {
+    if (!cond) {
+        std::printf("FAILED: %s\n", what);
+        s_ok = false;
+    }
+}
+
+static constexpr std::string_view BLOCK = "1,1,2,15,3,15,21,3";
+static constexpr std::string_view BLOCK_MOVED = "1,1,2,105,3,45,21,3";
+static constexpr std::string_view BLOCK_MOVED_ELSEWHERE = "1,1,2,315,3,15,21,3";
+static constexpr std::string_view BLOCK_MOVED_RECOLORED = "1,1,2,105,3,45,21,4";
+static constexpr std::string_view SPIKE = "1,8,2,45,3,15";
+static constexpr std::string_view SPIKE_RECOLORED = "1,8,2,45,3,15,21,6";
+static constexpr std::string_view DECO = "1,211,2,75,3,15,57,5";
+
+int main() {
+    const auto base = level({ BLOCK, SPIKE, DECO });
+
+    {
+        auto diff = be::LevelDiff::compute(base, level({ BLOCK_MOVED, SPIKE, DECO }));
+        check(diff.modified.size() == 1 && diff.added.empty() && diff.removed.empty(), "a move is a modification");
+        diff = be::LevelDiff::compute(base, level({ SPIKE, DECO, BLOCK_MOVED_RECOLORED }));
+        check(diff.modified.empty() && diff.added.size() == 1 && diff.removed.size() == 1, "a move with other changes is a removal and an addition");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ BLOCK_MOVED, SPIKE, DECO }), level({ BLOCK, SPIKE_RECOLORED, DECO }));
+        check(merge.conflicts.empty(), "a move and an unrelated change don't conflict");
+        check(merge.objectIDs.size() == 3, "a move and an unrelated change keep every object once");
+        check(count(merge.levelString, BLOCK_MOVED) == 1 && count(merge.levelString, SPIKE_RECOLORED) == 1, "a move and an unrelated change are both taken");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ BLOCK, SPIKE, DECO }), level({ SPIKE, BLOCK_MOVED, DECO }));
+        check(merge.conflicts.empty() && merge.objectIDs.size() == 3, "their move is taken without conflicts");
+        check(count(merge.levelString, BLOCK_MOVED) == 1 && count(merge.levelString, BLOCK) == 0, "their move replaces the original");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ BLOCK_MOVED, SPIKE, DECO }), level({ BLOCK_MOVED, SPIKE, DECO }));
+        check(merge.conflicts.empty() && merge.objectIDs.size() == 3, "the same move on both sides doesn't conflict");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ BLOCK_MOVED, SPIKE, DECO }), level({ BLOCK_MOVED_ELSEWHERE, SPIKE, DECO }));
+        check(merge.conflicts.size() == 2, "moves to different places conflict");
+        check(count(merge.levelString, BLOCK_MOVED) == 1 && count(merge.levelString, BLOCK_MOVED_ELSEWHERE) == 1, "moves to different places keep both");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ BLOCK_MOVED, SPIKE, DECO }), level({ SPIKE, DECO }));
+        check(merge.conflicts.size() == 1 && count(merge.levelString, BLOCK_MOVED) == 1, "our move and their delete conflict");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ SPIKE, DECO }), level({ DECO, SPIKE, BLOCK_MOVED }));
+        check(merge.conflicts.size() == 1 && count(merge.levelString, BLOCK_MOVED) == 1, "our delete and their move conflict");
+    }
+    {
+        auto merge = be::LevelMerge::compute(base, level({ SPIKE, DECO }), level({ BLOCK, SPIKE, DECO }));
+        check(merge.conflicts.empty() && merge.objectIDs.size() == 2, "our delete is taken when they didn't touch the object");
+    }
+
+    if (s_ok) {
+        std::printf("All merge checks passed\n");
+    }
+    return s_ok ? 0 : 1;
+}
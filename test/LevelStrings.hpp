@@ -0,0 +1,53 @@
+#pragma once
+
+#include <fmt/format.h>
+#include <random>
+#include <string>
+
+// Decompressed level strings, which is what backup chunks hold. There are no 
+// real levels in the repo, so these are made up of the same kinds of objects 
+// in roughly the same proportions as a deco-heavy level: mostly blocks and 
+// deco on a 30 unit grid with colors, some rotated and scaled detail, some 
+// grouped and a few triggers
+inline std::string generateLevelString(size_t objectCount, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> blockID(1, 300);
+    std::uniform_int_distribution<int> decoID(1700, 1900);
+    std::uniform_int_distribution<int> triggerID(0, 5);
+    std::uniform_int_distribution<int> gridX(0, 4000);
+    std::uniform_int_distribution<int> gridY(0, 60);
+    std::uniform_int_distribution<int> color(1, 40);
+    std::uniform_int_distribution<int> group(1, 300);
+    std::uniform_real_distribution<float> fine(0, 30);
+    constexpr int TRIGGER_IDS[] = { 901, 1006, 1007, 1049, 1268, 1346 };
+
+    std::string str = "kS38,1_40_2_125_3_255_11_255_12_255_13_255_4_-1_6_1000_7_1_15_1_18_0_8_1|,kA13,0,kA15,0,kA16,0;";
+    str.reserve(objectCount * 48);
+    for (size_t i = 0; i < objectCount; i += 1) {
+        const auto kind = percent(rng);
+        const auto x = gridX(rng) * 30 + 15;
+        const auto y = gridY(rng) * 30 + 15;
+        if (kind < 55) {
+            str += fmt::format("1,{},2,{},3,{},21,{}", blockID(rng), x, y, color(rng));
+        }
+        else if (kind < 90) {
+            str += fmt::format(
+                "1,{},2,{:.2f},3,{:.2f},6,{},32,{:.2f},21,{},24,{}",
+                decoID(rng), x + fine(rng), y + fine(rng),
+                percent(rng) * 3 - 150, .5f + percent(rng) / 100.f, color(rng), percent(rng) % 5 + 1
+            );
+        }
+        else if (kind < 97) {
+            str += fmt::format("1,{},2,{},3,{},21,{},57,{}.{}", blockID(rng), x, y, color(rng), group(rng), group(rng));
+        }
+        else {
+            str += fmt::format(
+                "1,{},2,{},3,{},36,1,51,{},10,{:.2f},30,{},85,2",
+                TRIGGER_IDS[triggerID(rng)], x, y, group(rng), percent(rng) / 20.f, percent(rng) % 10
+            );
+        }
+        str += ';';
+    }
+    return str;
+}
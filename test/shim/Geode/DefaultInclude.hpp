@@ -0,0 +1,30 @@
+#pragma once
+
+// Just enough of Geode for the parts of BetterEdit that are pure logic to be
+// compiled and run on a desktop machine without the game
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "Result.hpp"
+
+namespace cocos2d {}
+namespace gd {
+    using string = std::string;
+}
+namespace geode {
+    namespace utils {}
+    namespace prelude {
+        using namespace cocos2d;
+        using namespace geode;
+        using namespace geode::utils;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <fmt/format.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// The parts of Geode's Result that BetterEdit's pure logic uses
+
+namespace geode {
+    namespace impl {
+        struct OkVoid final {};
+        template <class T>
+        struct OkValue final {
+            T value;
+        };
+        struct ErrValue final {
+            std::string error;
+        };
+    }
+
+    template <class T = void, class E = std::string>
+    class [[nodiscard]] Result final {
+    protected:
+        using Value = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+        std::variant<Value, E> m_value;
+
+    public:
+        Result(impl::OkVoid) requires std::is_void_v<T> : m_value(std::in_place_index<0>) {}
+        template <class V>
+        Result(impl::OkValue<V>&& ok) : m_value(std::in_place_index<0>, std::move(ok.value)) {}
+        Result(impl::ErrValue&& err) : m_value(std::in_place_index<1>, std::move(err.error)) {}
+
+        bool isOk() const { return m_value.index() == 0; }
+        bool isErr() const { return m_value.index() == 1; }
+        explicit operator bool() const { return this->isOk(); }
+
+        Value& unwrap() { return std::get<0>(m_value); }
+        E& unwrapErr() { return std::get<1>(m_value); }
+    };
+
+    inline impl::OkVoid Ok() {
+        return {};
+    }
+    template <class T>
+    impl::OkValue<std::decay_t<T>> Ok(T&& value) {
+        return { std::forward<T>(value) };
+    }
+    template <class... Args>
+    impl::ErrValue Err(fmt::format_string<Args...> format, Args&&... args) {
+        return { fmt::format(format, std::forward<Args>(args)...) };
+    }
+}
+
+#define GEODE_SHIM_CONCAT2(a, b) a##b
+#define GEODE_SHIM_CONCAT(a, b) GEODE_SHIM_CONCAT2(a, b)
+#define GEODE_UNWRAP_INTO(into, ...) \
+    auto GEODE_SHIM_CONCAT(unwrap_res_, __LINE__) = (__VA_ARGS__); \
+    if (GEODE_SHIM_CONCAT(unwrap_res_, __LINE__).isErr()) { \
+        return ::geode::impl::ErrValue { std::move(GEODE_SHIM_CONCAT(unwrap_res_, __LINE__).unwrapErr()) }; \
+    } \
+    into = std::move(GEODE_SHIM_CONCAT(unwrap_res_, __LINE__).unwrap())
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// The subset of cocos2d geometry that BetterEdit's layout code uses, with the
+// same semantics as the engine
+
+using GLfloat = float;
+using GLubyte = uint8_t;
+
+namespace cocos2d {
+    class CCSize {
+    public:
+        float width = 0;
+        float height = 0;
+
+        CCSize() = default;
+        CCSize(float width, float height) : width(width), height(height) {}
+
+        bool equals(CCSize const& other) const {
+            return width == other.width && height == other.height;
+        }
+    };
+
+    class CCPoint {
+    public:
+        float x = 0;
+        float y = 0;
+
+        CCPoint() = default;
+        CCPoint(float x, float y) : x(x), y(y) {}
+        CCPoint(CCSize const& size) : x(size.width), y(size.height) {}
+
+        CCPoint operator+(CCPoint const& other) const { return CCPoint(x + other.x, y + other.y); }
+        CCPoint operator-(CCPoint const& other) const { return CCPoint(x - other.x, y - other.y); }
+        CCPoint operator*(float a) const { return CCPoint(x * a, y * a); }
+        CCPoint& operator+=(CCPoint const& other) {
+            x += other.x;
+            y += other.y;
+            return *this;
+        }
+
+        bool equals(CCPoint const& other) const {
+            return x == other.x && y == other.y;
+        }
+        float getAngle() const {
+            return atan2f(y, x);
+        }
+        static CCPoint forAngle(float a) {
+            return CCPoint(cosf(a), sinf(a));
+        }
+    };
+
+    class CCRect {
+    public:
+        CCPoint origin;
+        CCSize size;
+
+        CCRect() = default;
+        CCRect(float x, float y, float width, float height)
+          : origin(x, y), size(width, height) {}
+
+        float getMinX() const { return origin.x; }
+        float getMidX() const { return origin.x + size.width / 2.f; }
+        float getMaxX() const { return origin.x + size.width; }
+        float getMinY() const { return origin.y; }
+        float getMidY() const { return origin.y + size.height / 2.f; }
+        float getMaxY() const { return origin.y + size.height; }
+
+        bool equals(CCRect const& other) const {
+            return origin.equals(other.origin) && size.equals(other.size);
+        }
+        bool intersectsRect(CCRect const& rect) const {
+            return !(
+                getMaxX() < rect.getMinX() || rect.getMaxX() < getMinX() ||
+                getMaxY() < rect.getMinY() || rect.getMaxY() < getMinY()
+            );
+        }
+    };
+
+    struct ccColor4B {
+        GLubyte r;
+        GLubyte g;
+        GLubyte b;
+        GLubyte a;
+    };
+
+    inline CCPoint ccp(float x, float y) {
+        return CCPoint(x, y);
+    }
+    inline ccColor4B ccc4(GLubyte r, GLubyte g, GLubyte b, GLubyte a) {
+        return ccColor4B { r, g, b, a };
+    }
+
+    inline const CCRect CCRectZero = CCRect(0, 0, 0, 0);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <algorithm>
+
+namespace geode::utils::ranges {
+    template <class C, class F>
+    void remove(C& container, F&& fun) {
+        container.erase(
+            std::remove_if(container.begin(), container.end(), fun),
+            container.end()
+        );
+    }
+}